@@ -0,0 +1,125 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Helpers shared by the benchmarks of the hardware packages: CPU time and
+* 	thread count of the process, a peer echoing '$...\r' frames and, when
+* 	BENCHMARK_COUNT_ALLOCATIONS is defined before including it, a count of all
+* 	heap allocations. Header only, include it in the benchmark's only
+* 	translation unit.
+*
+***********************************************************************************/
+
+#ifndef BENCHMARK_UTILS_HPP
+#define BENCHMARK_UTILS_HPP
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <fstream>
+#include <new>
+#include <string>
+
+//! @return The CPU time used by all threads of the process so far [s].
+inline double cpuTime()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return 	usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 +
+			usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+}
+
+//! @return The number of threads of the process, -1 if it could not be read.
+inline int nrOfThreads()
+{
+	std::ifstream 	status("/proc/self/status");
+	std::string 	line;
+	while(std::getline(status, line))
+	{
+		if(line.compare(0, 8, "Threads:") == 0)
+			return atoi(line.c_str() + 8);
+	}
+	return -1;
+}
+
+/**
+ * Answers every '$...\r' frame written to a descriptor with the same frame, like a controller echoing its commands.
+ */
+class FrameEcho
+{
+  public:
+	/**
+	 * Handles bytes read from the descriptor.
+	 * @return false if writing a response failed.
+	 */
+	bool handle(int fd, const char* bytes, ssize_t n_bytes)
+	{
+		for(ssize_t i = 0; i < n_bytes; i++)
+		{
+			if(bytes[i] == '$')
+				frame_.clear();
+			else if(bytes[i] != '\r')
+				frame_ += bytes[i];
+			else
+			{
+				std::string response = "$" + frame_ + "\r";
+				if(::write(fd, response.data(), response.size()) < 0)
+					return false;
+			}
+		}
+		return true;
+	}
+
+  private:
+	std::string frame_;
+};
+
+#ifdef BENCHMARK_COUNT_ALLOCATIONS
+
+// Counts all heap allocations of the process
+static std::atomic<uint64_t> n_allocations(0);
+
+void* operator new(size_t size)
+{
+	n_allocations++;
+	void* p = malloc(size);
+	if(p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	free(p);
+}
+
+#endif // BENCHMARK_COUNT_ALLOCATIONS
+
+#endif // BENCHMARK_UTILS_HPP
@@ -0,0 +1,129 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compares the throughput of the lock-free RingBuffer with the mutex protected
+* 	deque that Serial used as read buffer. A producer thread pushes blocks the size
+* 	of a serial read while a consumer thread drains them.
+* 
+***********************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "thread_safe_stl_containers/thread_safe_deque.h"
+#include "rose_hardware_comm/ring_buffer.hpp"
+
+#define BENCHMARK_BLOCK_SIZE		100					// [bytes], same as SERIAL_READ_BLOCK_SIZE
+#define BENCHMARK_TOTAL_BYTES		(BENCHMARK_BLOCK_SIZE * 640 * 1024)	// [bytes]
+#define BENCHMARK_RING_SIZE			65536				// [bytes], same as SERIAL_READ_BUFFER_SIZE
+
+using namespace std;
+
+void report(const char* name, chrono::steady_clock::duration duration, uint64_t n_bytes, uint64_t checksum)
+{
+	double seconds = chrono::duration<double>(duration).count();
+	printf("%-8s %8.1f MB/s  %6.2f ns/byte  (checksum %lu)\n", 
+			name, n_bytes / seconds / 1e6, seconds * 1e9 / n_bytes, (unsigned long)checksum);
+}
+
+// The previous Serial read path, bytes are pushed one by one under a lock and fetched as a copy
+void benchmarkDeque()
+{
+	thread_safe::deque<char> 	read_buffer;
+	mutex 						buffer_mutex;
+	uint64_t 					checksum = 0;
+
+	auto start = chrono::steady_clock::now();
+	thread producer([&]()
+	{
+		char block[BENCHMARK_BLOCK_SIZE];
+		for(int i = 0; i < BENCHMARK_BLOCK_SIZE; i++)
+			block[i] = i;
+
+		for(uint64_t written = 0; written < BENCHMARK_TOTAL_BYTES; written += BENCHMARK_BLOCK_SIZE)
+		{
+			buffer_mutex.lock();
+			for(int i = 0; i < BENCHMARK_BLOCK_SIZE; i++)
+				read_buffer.push_back(block[i]);
+			buffer_mutex.unlock();
+		}
+	});
+
+	thread_safe::deque<char> fetched;
+	uint64_t n_read = 0;
+	while(n_read < BENCHMARK_TOTAL_BYTES)
+	{
+		if(!read_buffer.empty())
+		{
+			buffer_mutex.lock();
+			fetched = read_buffer;
+			read_buffer.clear();
+			buffer_mutex.unlock();
+
+			for(auto it = fetched.begin(); it != fetched.end(); it++)
+				checksum += *it;
+			n_read += fetched.size();
+		}
+		else
+			this_thread::yield();
+	}
+	producer.join();
+	report("deque", chrono::steady_clock::now() - start, n_read, checksum);
+}
+
+void benchmarkRingBuffer()
+{
+	RingBuffer 	read_buffer(BENCHMARK_RING_SIZE);
+	uint64_t 	checksum = 0;
+
+	auto start = chrono::steady_clock::now();
+	thread producer([&]()
+	{
+		char block[BENCHMARK_BLOCK_SIZE];
+		for(int i = 0; i < BENCHMARK_BLOCK_SIZE; i++)
+			block[i] = i;
+
+		uint64_t written = 0;
+		while(written < BENCHMARK_TOTAL_BYTES)
+		{
+			// Do not count overflows, only write complete blocks
+			if(read_buffer.capacity() - read_buffer.size() >= BENCHMARK_BLOCK_SIZE)
+				written += read_buffer.write(block, BENCHMARK_BLOCK_SIZE);
+			else
+				this_thread::yield();
+		}
+	});
+
+	uint64_t n_read = 0;
+	while(n_read < BENCHMARK_TOTAL_BYTES)
+	{
+		const char* span;
+		uint32_t 	span_length = read_buffer.peek(&span);
+		if(span_length == 0)
+			this_thread::yield();
+
+		for(uint32_t i = 0; i < span_length; i++)
+			checksum += span[i];
+		read_buffer.consume(span_length);
+		n_read += span_length;
+	}
+	producer.join();
+	report("ring", chrono::steady_clock::now() - start, n_read, checksum);
+	printf("ring overflows: %lu (%lu bytes)\n", (unsigned long)read_buffer.get_overflow_count(), (unsigned long)read_buffer.get_overflow_bytes());
+}
+
+int main(int argc, char** argv)
+{
+	benchmarkDeque();
+	benchmarkRingBuffer();
+	return 0;
+}
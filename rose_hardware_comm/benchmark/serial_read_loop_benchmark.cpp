@@ -0,0 +1,92 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compares the polling and the event driven serial read loop. A pseudo terminal
+* 	is used as serial port, the benchmark reports the CPU time and read syscalls used
+* 	while the line is idle and the latency from writing a byte to it being available
+* 	in the buffer.
+*
+***********************************************************************************/
+
+#include <pty.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "rose_hardware_comm/serial.hpp"
+
+#define BENCHMARK_IDLE_TIME			2		// [s]
+#define BENCHMARK_LATENCY_SAMPLES	2000
+
+using namespace std;
+
+bool benchmark(const char* name, SerialReadMode read_mode)
+{
+	int master_fd, slave_fd;
+	char slave_name[256];
+	if(openpty(&master_fd, &slave_fd, slave_name, NULL, NULL) < 0)
+	{
+		printf("Could not open pseudo terminal: %s\n", strerror(errno));
+		return false;
+	}
+
+	Serial serial("benchmark", slave_name, B115200, read_mode);
+	if(!serial.connect())
+		return false;
+
+	// Idle CPU usage
+	serial.resetCommStats();
+	double cpu_start = cpuTime();
+	sleep(BENCHMARK_IDLE_TIME);
+	double 		idle_cpu 	= (cpuTime() - cpu_start) / BENCHMARK_IDLE_TIME;
+	CommStats 	idle_stats 	= serial.getCommStats();
+
+	// Write to buffer latency
+	thread_safe::deque<char> buffer;
+	vector<double> latencies;
+	for(int i = 0; i < BENCHMARK_LATENCY_SAMPLES; i++)
+	{
+		char byte = 'a' + i % 26;
+		auto start = chrono::steady_clock::now();
+		if(::write(master_fd, &byte, 1) != 1)
+			return false;
+
+		while(!serial.fetchBuffer(&buffer)) {}
+
+		latencies.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+		buffer.clear();
+	}
+	sort(latencies.begin(), latencies.end());
+
+	double mean = 0.0;
+	for(auto latency : latencies)
+		mean += latency;
+	mean /= latencies.size();
+
+	printf("%-8s idle cpu: %6.2f%%  idle reads/s: %8.1f  latency [us] mean: %7.1f  p50: %7.1f  p99: %7.1f  max: %7.1f\n",
+			name, idle_cpu * 100.0, (double)idle_stats.n_read_calls / BENCHMARK_IDLE_TIME, mean,
+			latencies[latencies.size() / 2],
+			latencies[latencies.size() * 99 / 100],
+			latencies.back());
+
+	serial.disconnect();
+	close(slave_fd);
+	close(master_fd);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(!benchmark("polling", SERIAL_READ_MODE_POLLING))
+		return 1;
+	if(!benchmark("event", SERIAL_READ_MODE_EVENT))
+		return 1;
+	return 0;
+}
@@ -16,13 +16,67 @@
 
 #include <iostream>
 #include <stdio.h>
+#include <stdint.h>
 
+#include <atomic>
+
+#include <boost/shared_ptr.hpp>
 #include <ros/ros.h>
 
 #include "thread_safe_stl_containers/thread_safe_deque.h"
 
+#define HARDWARE_COMM_WAIT_FOREVER 		UINT32_MAX 	// Timeout of waitForData() without a limit
+#define HARDWARE_COMM_DUMMY_WAIT 		2000 		// [us] Longest sleep of the dummy waitForData(), it can not be interrupted
+
 using namespace std;
 
+/**
+ * Snapshot of the transport counters of a communication interface, counted since the last reset.
+ */
+struct CommStats
+{
+	CommStats();
+
+	uint64_t 	bytes_read;
+	uint64_t 	bytes_written;
+	uint64_t 	n_read_calls;			// read() syscalls
+	uint64_t 	n_write_calls;			// write() syscalls
+	uint64_t 	n_poll_calls;			// poll() syscalls waiting for the port
+	uint64_t 	n_empty_reads;			// Reads that returned no bytes
+	uint64_t 	n_would_block;			// Reads and writes that failed with EAGAIN
+	uint64_t 	n_short_writes;			// Writes that wrote only part of the bytes
+	uint64_t 	n_errors;
+	uint64_t 	n_reconnects;			// Connects after the first one
+	uint32_t 	buffer_high_water;		// Largest number of bytes in the read buffer [bytes]
+};
+
+/**
+ * The counters behind CommStats, shared by the copies of an interface. Updated with relaxed atomics, such that
+ * counting costs no more than an uncontended increment per syscall.
+ */
+struct CommCounters
+{
+	CommCounters();
+
+	CommStats 	snapshot() const;
+	void 		reset();
+	void 		countRead(long n_read);
+	void 		countWrite(long n_written, uint32_t n_requested);
+	void 		countBuffered(uint32_t buffer_size);
+
+	std::atomic<uint64_t> 	bytes_read;
+	std::atomic<uint64_t> 	bytes_written;
+	std::atomic<uint64_t> 	n_read_calls;
+	std::atomic<uint64_t> 	n_write_calls;
+	std::atomic<uint64_t> 	n_poll_calls;
+	std::atomic<uint64_t> 	n_empty_reads;
+	std::atomic<uint64_t> 	n_would_block;
+	std::atomic<uint64_t> 	n_short_writes;
+	std::atomic<uint64_t> 	n_errors;
+	std::atomic<uint64_t> 	n_reconnects;
+	std::atomic<uint32_t> 	buffer_high_water;
+};
+
 class HardwareComm
 {
   public:
@@ -44,9 +98,30 @@ class HardwareComm
 
 	virtual bool 	fetchBuffer(thread_safe::deque<char>* buffer) = 0;
 
+	// Zero-copy access to the received bytes, borrow a read-only span and commit what has been consumed.
+	// The span stays valid until it is committed, a following borrow returns the remaining bytes.
+	virtual uint32_t 	borrowBuffer(const char** data);
+	virtual void 		commitBuffer(uint32_t n_consumed);
+
+	// Blocks until new bytes have been received, interruptWait() is called or the timeout [us] expired.
+	virtual bool 		waitForData(uint32_t timeout);
+	// Makes a thread blocked in waitForData() return, also when it starts waiting after this call.
+	virtual void 		interruptWait();
+
+	// Whether the owner reads the received bytes itself, with readBlock() when the poll descriptor is readable,
+	// instead of a read thread of the interface buffering them.
+	virtual bool 		isReadExternally();
+	virtual int 		getPollDescriptor();
+
+	// Transport counters, interfaces that do not count report zeros.
+	CommStats 			getCommStats();
+	void 				resetCommStats();
+
   protected:
   	bool 			set_connected(bool connection_status);
 
+	boost::shared_ptr<CommCounters> 	counters_;
+
   private:
 	string 			type_;
 	bool			connected_;
@@ -0,0 +1,136 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Reactor multiplexing many communication endpoints on one epoll set. The
+* 	number of threads serving the set is independent of the number of endpoints,
+* 	events of one endpoint are never handled by two threads at the same time.
+*
+***********************************************************************************/
+
+#ifndef IO_REACTOR_HPP
+#define IO_REACTOR_HPP
+
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include "ros_name/ros_name.hpp"
+
+#define ROS_NAME_REACTOR 				(ROS_NAME + "|REACTOR")
+
+#define IO_REACTOR_IDLE_WAIT			100		// [ms] Maximum time a thread waits for an event
+#define IO_REACTOR_MAX_EVENTS			64		// Events handled per wait
+
+/**
+ * An endpoint served by an IoReactor, for example a controller owning a serial port. The reactor serializes
+ * the calls for an endpoint, so the endpoint does not need to lock its read state.
+ */
+class ReactorEndpoint
+{
+  public:
+	virtual ~ReactorEndpoint();
+
+	//! @return The descriptor to wait for input on, -1 if there is none, for example while disconnected.
+	virtual int 	getPollDescriptor() = 0;
+
+	//! The descriptor is readable.
+	virtual void 	handleReadable() = 0;
+
+	//! The descriptor hung up or is in error.
+	virtual void 	handleHangup() = 0;
+
+	//! IoReactor::wake() has been called for the endpoint, for example because there is something to write.
+	virtual void 	handleWake() = 0;
+
+	/**
+	 * Handles the deadlines that have passed.
+	 * @return The next deadline, time_point::max() if there is none.
+	 */
+	virtual std::chrono::steady_clock::time_point 	handleTimeouts(std::chrono::steady_clock::time_point now) = 0;
+};
+
+/**
+ * IoReactor class, a pool of threads waiting on one epoll set for the descriptors and the wake events of all
+ * its endpoints.
+ */
+class IoReactor
+{
+  public:
+	/**
+	 * Constructor of the IoReactor class, starts the threads.
+	 * @param[in] unsigned int n_threads, the number of threads serving all endpoints.
+	 */
+	IoReactor(unsigned int n_threads = 1);
+	~IoReactor();
+
+	bool 		addEndpoint(ReactorEndpoint* endpoint);
+	//! Waits until the endpoint is not being handled anymore, it is not called after this returns.
+	void 		removeEndpoint(ReactorEndpoint* endpoint);
+
+	//! Makes a thread call handleWake() of the endpoint, can be called from any thread.
+	void 		wake(ReactorEndpoint* endpoint);
+
+	//! @return true if called from one of the threads of the reactor.
+	bool 		isReactorThread();
+
+	unsigned int 	get_nr_of_threads();
+	size_t 			get_nr_of_endpoints();
+
+  private:
+	IoReactor(const IoReactor&);
+	IoReactor& operator=(const IoReactor&);
+
+	struct Registration;
+
+	// What an epoll event refers to
+	struct Source
+	{
+		Registration* 	registration;
+		bool 			is_wake;
+	};
+
+	struct Registration
+	{
+		ReactorEndpoint* 						endpoint;
+		std::mutex 								mutex;			// Held while the endpoint is being handled
+		bool 									removed;
+		int 									fd;				// Registered descriptor of the endpoint
+		int 									wake_fd;		// Closed when the endpoint is removed
+		Source 									fd_source;
+		Source 									wake_source;
+		std::atomic<int64_t> 					next_deadline;	// In steady_clock ticks, written under mutex and read by waitTime() without it
+	};
+
+	void 		run();
+	void 		handle(Source* source, uint32_t events);
+	void 		handleTimeouts();
+	void 		arm(int fd, Source* source);
+	void 		refresh(Registration* registration);
+	int 		waitTime();
+
+	int 										epoll_fd_;
+	int 										stop_fd_;
+	std::vector<std::thread> 					threads_;
+
+	std::mutex 									mutex_;
+	std::map<ReactorEndpoint*, Registration*> 	registrations_;
+	std::list<Registration*> 					removed_;		// Without descriptors, freed on destruction as events for them can still be pending
+};
+
+#endif // IO_REACTOR_HPP
@@ -0,0 +1,95 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Fixed capacity single-producer/single-consumer byte ring buffer. The producer
+* 	copies in blocks, the consumer borrows contiguous spans, neither takes a lock.
+* 
+***********************************************************************************/
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#define RING_BUFFER_CACHE_LINE_SIZE		64 // [bytes]
+
+class RingBuffer
+{
+  public:
+	/**
+	 * Constructor of the RingBuffer class.
+	 * @param[in] uint32_t capacity, the capacity in bytes, rounded up to a power of two.
+	 */
+	RingBuffer(uint32_t capacity);
+	~RingBuffer();
+
+	/**
+	 * Producer side, copies as many bytes as fit into the buffer.
+	 * Bytes that do not fit are dropped and counted as overflow.
+	 * @return The number of bytes written.
+	 */
+	uint32_t 	write(const char* data, uint32_t length);
+
+	/**
+	 * Producer side, marks all bytes written so far as stale. The consumer skips them in its next peek(), a span it
+	 * borrowed before stays valid until it is consumed.
+	 */
+	void 		discardWritten();
+
+	/**
+	 * Consumer side, borrows the contiguous span of readable bytes starting at the read position.
+	 * The span stays valid until it is consumed. When the readable data wraps around the end of
+	 * the buffer a second peek after consuming the first span returns the remainder.
+	 * @param[out] const char** data, set to the start of the span.
+	 * @return The length of the span, 0 if the buffer is empty.
+	 */
+	uint32_t 	peek(const char** data);
+
+	/**
+	 * Consumer side, releases the first length bytes returned by peek(), at most up to the write position.
+	 */
+	void 		consume(uint32_t length);
+
+	/**
+	 * Consumer side, discards all readable bytes.
+	 */
+	void 		clear();
+
+	uint32_t 	size();
+	uint32_t 	capacity();
+	bool 		empty();
+
+	//! @return The number of bytes dropped because the buffer was full.
+	uint64_t 	get_overflow_bytes();
+	//! @return The number of writes that did not fit completely.
+	uint64_t 	get_overflow_count();
+
+  private:
+	RingBuffer(const RingBuffer&);
+	RingBuffer& operator=(const RingBuffer&);
+
+	char* 					buffer_;
+	uint32_t 				capacity_;
+	uint32_t 				mask_;
+
+	// Keep the producer and consumer positions on separate cache lines
+	char 					padding_0_[RING_BUFFER_CACHE_LINE_SIZE];
+	std::atomic<uint64_t> 	head_;			// Written by the producer
+	std::atomic<uint64_t> 	stale_head_;	// Written by the producer, the consumer skips the bytes before it
+	char 					padding_1_[RING_BUFFER_CACHE_LINE_SIZE];
+	std::atomic<uint64_t> 	tail_;			// Written by the consumer
+	char 					padding_2_[RING_BUFFER_CACHE_LINE_SIZE];
+
+	std::atomic<uint64_t> 	overflow_bytes_;
+	std::atomic<uint64_t> 	overflow_count_;
+};
+
+#endif // RING_BUFFER_HPP
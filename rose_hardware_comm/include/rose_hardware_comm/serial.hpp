@@ -21,6 +21,8 @@
 #include <fcntl.h>
 #include <termios.h>
 #include <string.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 
 #include <thread> 
 #include <mutex> 
@@ -30,19 +32,45 @@
 
 #include "thread_safe_stl_containers/thread_safe_deque.h"
 #include "rose_hardware_comm/hardware_comm.hpp"
+#include "rose_hardware_comm/ring_buffer.hpp"
 #include "ros_name/ros_name.hpp"
 
 #define ROS_NAME_SERIAL 					(ROS_NAME + "|SERIAL")
 
 #define SERIAL_SLOW_BLOCK_WRITE_DELAY		400 // [us]
+#define SERIAL_WRITE_TIMEOUT				100 // [ms] Maximum wait for the port to become writable
+#define SERIAL_POLL_INTERVAL				100 // [us]
+#define SERIAL_READ_BLOCK_SIZE				100 // [bytes]
+#define SERIAL_READ_BUFFER_SIZE				65536 // [bytes]
+
+/**
+ * Selects how the read loop waits for incoming data.
+ */
+enum SerialReadMode
+{
+	SERIAL_READ_MODE_POLLING,		// Wake every SERIAL_POLL_INTERVAL and do a non-blocking read
+	SERIAL_READ_MODE_EVENT,			// Sleep in poll() until data arrives or a stop is requested
+	SERIAL_READ_MODE_EXTERNAL,		// No read thread, the owner polls getPollDescriptor() and calls readBlock()
+};
 
 using namespace std;
 
+/**
+ * eventfd that lives as long as the Serial objects sharing it, such that a consumer never polls a closed or reused descriptor.
+ */
+struct SerialEvent
+{
+	SerialEvent();
+	~SerialEvent();
+
+	const int 	fd; 		// -1 if it could not be created
+};
+
 class Serial : public HardwareComm 
 {
 	public:
 		Serial();
-		Serial(string parent_name, string port, uint baudrate);
+		Serial(string parent_name, string port, uint baudrate, SerialReadMode read_mode = SERIAL_READ_MODE_POLLING);
 		~Serial();
 
 		bool   				connect();
@@ -57,26 +85,42 @@ class Serial : public HardwareComm
 	
 		bool 				is_ok();
 
+		bool 				set_read_mode(SerialReadMode read_mode);
+		SerialReadMode 		get_read_mode();
+
 		bool 				fetchBuffer(thread_safe::deque<char>* buffer);
+		uint32_t 			borrowBuffer(const char** data);
+		void 				commitBuffer(uint32_t n_consumed);
+		bool 				waitForData(uint32_t timeout);
+		void 				interruptWait();
+		bool 				isReadExternally();
+		int 				getPollDescriptor();
 
 	protected:
 		bool 				spawnReadloop();
 		void 				stopReadloop();
 		void 				readLoop();		
+		void 				pollingReadLoop();
+		void 				eventReadLoop();
+		void 				bufferBytes(const char* bytes, int n_bytes);
 
 		string 				port_;
 		uint 				baudrate_;
 		int 				file_descriptor_;
 		bool 				happy_;
+		bool 				was_connected_;		// Later connects are counted as reconnects
 
-		boost::shared_ptr<mutex>	buffer_mutex_;
 		boost::shared_ptr<thread>	read_thread_;
-		thread_safe::deque<char>	read_buffer_;
+		boost::shared_ptr<RingBuffer>	read_buffer_;	// Read thread is the producer, fetchBuffer() the consumer
 		bool 						read_thread_spawned_;
 		
 		bool 		 				stop_read_loop_;
 		boost::shared_ptr<mutex>	stop_read_loop_mutex_;
 
+		SerialReadMode 				read_mode_;
+		int 						stop_event_fd_;		// eventfd used to wake the event read loop on stop
+		boost::shared_ptr<SerialEvent> 	data_event_;	// Signalled by the read loop when bytes have been buffered, shared by the copies
+
 		ros::Time 					start_time_;
 		ros::Time 					end_time_;
 
@@ -13,10 +13,103 @@
 
 #include "rose_hardware_comm/hardware_comm.hpp"
 
+#include <errno.h>
+
+#include <algorithm>
+
 using namespace std;
 
+CommStats::CommStats()
+	: bytes_read(0)
+	, bytes_written(0)
+	, n_read_calls(0)
+	, n_write_calls(0)
+	, n_poll_calls(0)
+	, n_empty_reads(0)
+	, n_would_block(0)
+	, n_short_writes(0)
+	, n_errors(0)
+	, n_reconnects(0)
+	, buffer_high_water(0)
+{}
+
+CommCounters::CommCounters()
+{
+	reset();
+}
+
+CommStats CommCounters::snapshot() const
+{
+	CommStats stats;
+	stats.bytes_read 		= bytes_read.load(std::memory_order_relaxed);
+	stats.bytes_written 	= bytes_written.load(std::memory_order_relaxed);
+	stats.n_read_calls 		= n_read_calls.load(std::memory_order_relaxed);
+	stats.n_write_calls 	= n_write_calls.load(std::memory_order_relaxed);
+	stats.n_poll_calls 		= n_poll_calls.load(std::memory_order_relaxed);
+	stats.n_empty_reads 	= n_empty_reads.load(std::memory_order_relaxed);
+	stats.n_would_block 	= n_would_block.load(std::memory_order_relaxed);
+	stats.n_short_writes 	= n_short_writes.load(std::memory_order_relaxed);
+	stats.n_errors 			= n_errors.load(std::memory_order_relaxed);
+	stats.n_reconnects 		= n_reconnects.load(std::memory_order_relaxed);
+	stats.buffer_high_water = buffer_high_water.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void CommCounters::reset()
+{
+	bytes_read.store(0, std::memory_order_relaxed);
+	bytes_written.store(0, std::memory_order_relaxed);
+	n_read_calls.store(0, std::memory_order_relaxed);
+	n_write_calls.store(0, std::memory_order_relaxed);
+	n_poll_calls.store(0, std::memory_order_relaxed);
+	n_empty_reads.store(0, std::memory_order_relaxed);
+	n_would_block.store(0, std::memory_order_relaxed);
+	n_short_writes.store(0, std::memory_order_relaxed);
+	n_errors.store(0, std::memory_order_relaxed);
+	n_reconnects.store(0, std::memory_order_relaxed);
+	buffer_high_water.store(0, std::memory_order_relaxed);
+}
+
+// Counts a read() syscall and its result
+void CommCounters::countRead(long n_read)
+{
+	n_read_calls.fetch_add(1, std::memory_order_relaxed);
+	if(n_read > 0)
+		bytes_read.fetch_add(n_read, std::memory_order_relaxed);
+	else if(n_read == 0)
+		n_empty_reads.fetch_add(1, std::memory_order_relaxed);
+	else if(errno == EAGAIN || errno == EWOULDBLOCK)
+		n_would_block.fetch_add(1, std::memory_order_relaxed);
+	else if(errno != EINTR)
+		n_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Counts a write() syscall and its result
+void CommCounters::countWrite(long n_written, uint32_t n_requested)
+{
+	n_write_calls.fetch_add(1, std::memory_order_relaxed);
+	if(n_written >= 0)
+	{
+		bytes_written.fetch_add(n_written, std::memory_order_relaxed);
+		if((uint32_t)n_written < n_requested)
+			n_short_writes.fetch_add(1, std::memory_order_relaxed);
+	}
+	else if(errno == EAGAIN || errno == EWOULDBLOCK)
+		n_would_block.fetch_add(1, std::memory_order_relaxed);
+	else if(errno != EINTR)
+		n_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Only the reading thread grows the buffer, so no compare-exchange is needed
+void CommCounters::countBuffered(uint32_t buffer_size)
+{
+	if(buffer_size > buffer_high_water.load(std::memory_order_relaxed))
+		buffer_high_water.store(buffer_size, std::memory_order_relaxed);
+}
+
 HardwareComm::HardwareComm()
-	: type_("")
+	: counters_(new CommCounters())
+	, type_("")
 	, connected_(false)
 {}
 
@@ -45,6 +138,50 @@ bool HardwareComm::disconnect()
 	return false;
 }
 
+// Dummy
+uint32_t HardwareComm::borrowBuffer(const char** data)
+{
+	*data = NULL;
+	return 0;
+}
+
+// Dummy
+void HardwareComm::commitBuffer(uint32_t)
+{}
+
+// Dummy, sleeps the timeout, at most HARDWARE_COMM_DUMMY_WAIT such that its caller notices interruptWait() in time
+bool HardwareComm::waitForData(uint32_t timeout)
+{
+	usleep(std::min<uint32_t>(timeout, HARDWARE_COMM_DUMMY_WAIT));
+	return false;
+}
+
+// Dummy, waitForData() returns by itself
+void HardwareComm::interruptWait()
+{}
+
+// Dummy, the interface buffers the received bytes itself
+bool HardwareComm::isReadExternally()
+{
+	return false;
+}
+
+// Dummy
+int HardwareComm::getPollDescriptor()
+{
+	return -1;
+}
+
+CommStats HardwareComm::getCommStats()
+{
+	return counters_->snapshot();
+}
+
+void HardwareComm::resetCommStats()
+{
+	counters_->reset();
+}
+
 bool HardwareComm::isConnected()
 {
 	return connected_;
@@ -0,0 +1,286 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Reactor multiplexing many communication endpoints on one epoll set.
+*
+***********************************************************************************/
+
+#include "rose_hardware_comm/io_reactor.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+ReactorEndpoint::~ReactorEndpoint()
+{}
+
+IoReactor::IoReactor(unsigned int n_threads)
+{
+	epoll_fd_ 	= epoll_create1(EPOLL_CLOEXEC);
+	stop_fd_ 	= eventfd(0, EFD_NONBLOCK);
+	if(epoll_fd_ < 0 || stop_fd_ < 0)
+	{
+		ROS_ERROR_NAMED(ROS_NAME_REACTOR, "Could not create the epoll set of the reactor: %s", strerror(errno));
+		return;
+	}
+
+	// Level triggered, once set it wakes all threads
+	struct epoll_event event;
+	event.events 	= EPOLLIN;
+	event.data.ptr 	= NULL;
+	if(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &event) < 0)
+	{
+		ROS_ERROR_NAMED(ROS_NAME_REACTOR, "Could not add the stop event to the epoll set of the reactor: %s", strerror(errno));
+		return;
+	}
+
+	for(unsigned int i = 0; i < n_threads; i++)
+		threads_.push_back(std::thread(&IoReactor::run, this));
+}
+
+IoReactor::~IoReactor()
+{
+	uint64_t one = 1;
+	if(stop_fd_ >= 0 && ::write(stop_fd_, &one, sizeof(one)) < 0)
+		ROS_WARN_NAMED(ROS_NAME_REACTOR, "Could not signal the stop event of the reactor.");
+
+	for(auto& thread : threads_)
+		thread.join();
+
+	for(auto& registration : registrations_)
+		removed_.push_back(registration.second);
+
+	for(auto& registration : removed_)
+	{
+		if(registration->wake_fd >= 0)
+			close(registration->wake_fd);
+		delete registration;
+	}
+
+	if(stop_fd_ >= 0)
+		close(stop_fd_);
+	if(epoll_fd_ >= 0)
+		close(epoll_fd_);
+}
+
+bool IoReactor::addEndpoint(ReactorEndpoint* endpoint)
+{
+	Registration* registration 	= new Registration();
+	registration->endpoint 		= endpoint;
+	registration->removed 		= false;
+	registration->fd 			= -1;
+	registration->wake_fd 		= eventfd(0, EFD_NONBLOCK);
+	registration->fd_source 	= Source{registration, false};
+	registration->wake_source 	= Source{registration, true};
+	registration->next_deadline.store(std::chrono::steady_clock::time_point::max().time_since_epoch().count());
+
+	if(registration->wake_fd < 0)
+	{
+		ROS_ERROR_NAMED(ROS_NAME_REACTOR, "Could not create the wake event of a reactor endpoint: %s", strerror(errno));
+		delete registration;
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if(registrations_.count(endpoint) != 0)
+		{
+			close(registration->wake_fd);
+			delete registration;
+			return false;
+		}
+		registrations_[endpoint] = registration;
+	}
+
+	std::lock_guard<std::mutex> lock(registration->mutex);
+	arm(registration->wake_fd, &registration->wake_source);
+	refresh(registration);
+
+	return true;
+}
+
+void IoReactor::removeEndpoint(ReactorEndpoint* endpoint)
+{
+	Registration* registration;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto found = registrations_.find(endpoint);
+		if(found == registrations_.end())
+			return;
+
+		registration = found->second;
+		registrations_.erase(found);
+		removed_.push_back(registration);
+	}
+
+	// Wait for a thread that is handling it. handle() checks removed first and wake() can no longer find it, so the
+	// wake event can be closed, only the registration is kept for the events that may still be pending.
+	std::lock_guard<std::mutex> lock(registration->mutex);
+	registration->removed = true;
+	epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration->wake_fd, NULL);
+	if(registration->fd >= 0)
+		epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, registration->fd, NULL);
+
+	close(registration->wake_fd);
+	registration->wake_fd = -1;
+}
+
+void IoReactor::wake(ReactorEndpoint* endpoint)
+{
+	// Written under the lock, such that the event is not closed in the meantime
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto found = registrations_.find(endpoint);
+	if(found == registrations_.end())
+		return;
+
+	uint64_t one = 1;
+	if(::write(found->second->wake_fd, &one, sizeof(one)) < 0)
+		ROS_DEBUG_NAMED(ROS_NAME_REACTOR, "Could not signal the wake event of a reactor endpoint.");
+}
+
+bool IoReactor::isReactorThread()
+{
+	for(auto& thread : threads_)
+	{
+		if(thread.get_id() == std::this_thread::get_id())
+			return true;
+	}
+
+	return false;
+}
+
+unsigned int IoReactor::get_nr_of_threads()
+{
+	return threads_.size();
+}
+
+size_t IoReactor::get_nr_of_endpoints()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return registrations_.size();
+}
+
+void IoReactor::run()
+{
+	struct epoll_event events[IO_REACTOR_MAX_EVENTS];
+	while(true)
+	{
+		int n_events = epoll_wait(epoll_fd_, events, IO_REACTOR_MAX_EVENTS, waitTime());
+		if(n_events < 0 && errno != EINTR)
+		{
+			ROS_WARN_NAMED(ROS_NAME_REACTOR, "Waiting for events failed: %s", strerror(errno));
+			return;
+		}
+
+		for(int i = 0; i < n_events; i++)
+		{
+			if(events[i].data.ptr == NULL)
+				return;
+
+			handle((Source*)events[i].data.ptr, events[i].events);
+		}
+
+		handleTimeouts();
+	}
+}
+
+void IoReactor::handle(Source* source, uint32_t events)
+{
+	Registration* registration = source->registration;
+
+	std::lock_guard<std::mutex> lock(registration->mutex);
+	if(registration->removed)
+		return;
+
+	ReactorEndpoint* endpoint = registration->endpoint;
+	if(source->is_wake)
+	{
+		uint64_t n_events;
+		if(::read(registration->wake_fd, &n_events, sizeof(n_events)) < 0)
+			ROS_DEBUG_NAMED(ROS_NAME_REACTOR, "Could not reset the wake event of a reactor endpoint.");
+
+		arm(registration->wake_fd, &registration->wake_source);
+		endpoint->handleWake();
+	}
+	else if(events & EPOLLIN)
+		endpoint->handleReadable();
+	else if(events & (EPOLLERR | EPOLLHUP))
+		endpoint->handleHangup();
+
+	registration->next_deadline.store(endpoint->handleTimeouts(std::chrono::steady_clock::now()).time_since_epoch().count());
+
+	// Handling may have reconnected the endpoint, also re-arms the descriptor
+	refresh(registration);
+}
+
+void IoReactor::handleTimeouts()
+{
+	std::vector<Registration*> registrations;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for(auto& registration : registrations_)
+			registrations.push_back(registration.second);
+	}
+
+	// Endpoints being handled by another thread are handled there, the registrations are not freed while running
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	for(auto& registration : registrations)
+	{
+		if(!registration->mutex.try_lock())
+			continue;
+
+		if(!registration->removed)
+		{
+			if(registration->next_deadline.load() <= now.time_since_epoch().count())
+				registration->next_deadline.store(registration->endpoint->handleTimeouts(now).time_since_epoch().count());
+
+			if(registration->endpoint->getPollDescriptor() != registration->fd)
+				refresh(registration);
+		}
+
+		registration->mutex.unlock();
+	}
+}
+
+void IoReactor::arm(int fd, Source* source)
+{
+	// One shot, such that only one thread gets the event, re-armed after it has been handled
+	struct epoll_event event;
+	event.events 	= EPOLLIN | EPOLLONESHOT;
+	event.data.ptr 	= source;
+
+	if(epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) < 0 && errno == ENOENT && epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+		ROS_WARN_NAMED(ROS_NAME_REACTOR, "Could not add descriptor %d to the epoll set of the reactor: %s", fd, strerror(errno));
+}
+
+void IoReactor::refresh(Registration* registration)
+{
+	// A closed descriptor has left the epoll set by itself, a new one is added by arm()
+	registration->fd = registration->endpoint->getPollDescriptor();
+	if(registration->fd >= 0)
+		arm(registration->fd, &registration->fd_source);
+}
+
+int IoReactor::waitTime()
+{
+	int64_t first_deadline = std::chrono::steady_clock::time_point::max().time_since_epoch().count();
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for(auto& registration : registrations_)
+			first_deadline = std::min(first_deadline, registration.second->next_deadline.load());
+	}
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(first_deadline));
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if(deadline <= now)
+		return 0;
+
+	// Rounded up, epoll waits in milliseconds
+	return std::min<int64_t>(IO_REACTOR_IDLE_WAIT, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count() / 1000 + 1);
+}
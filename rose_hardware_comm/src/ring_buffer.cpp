@@ -0,0 +1,121 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Fixed capacity single-producer/single-consumer byte ring buffer.
+* 
+***********************************************************************************/
+
+#include "rose_hardware_comm/ring_buffer.hpp"
+
+#include <algorithm>
+
+RingBuffer::RingBuffer(uint32_t capacity)
+	: head_(0)
+	, stale_head_(0)
+	, tail_(0)
+	, overflow_bytes_(0)
+	, overflow_count_(0)
+{
+	// Round up to a power of two such that positions can be masked
+	capacity_ = 1;
+	while(capacity_ < capacity)
+		capacity_ <<= 1;
+
+	mask_ 	= capacity_ - 1;
+	buffer_ = new char[capacity_];
+}
+
+RingBuffer::~RingBuffer()
+{
+	delete[] buffer_;
+}
+
+uint32_t RingBuffer::write(const char* data, uint32_t length)
+{
+	uint64_t head 	= head_.load(std::memory_order_relaxed);
+	uint64_t tail 	= tail_.load(std::memory_order_acquire);
+	uint32_t free 	= capacity_ - (uint32_t)(head - tail);
+
+	uint32_t n_write = std::min(length, free);
+	if(n_write < length)
+	{
+		overflow_bytes_.fetch_add(length - n_write, std::memory_order_relaxed);
+		overflow_count_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Copy in at most two parts, up to the end of the buffer and the wrapped remainder
+	uint32_t offset = (uint32_t)head & mask_;
+	uint32_t first 	= std::min(n_write, capacity_ - offset);
+	memcpy(buffer_ + offset, data, first);
+	memcpy(buffer_, data + first, n_write - first);
+
+	head_.store(head + n_write, std::memory_order_release);
+	return n_write;
+}
+
+void RingBuffer::discardWritten()
+{
+	stale_head_.store(head_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+uint32_t RingBuffer::peek(const char** data)
+{
+	// Skip the stale bytes here, such that only the consumer moves the tail
+	uint64_t tail 	= tail_.load(std::memory_order_relaxed);
+	uint64_t stale 	= stale_head_.load(std::memory_order_acquire);
+	if(tail < stale)
+	{
+		tail = stale;
+		tail_.store(tail, std::memory_order_release);
+	}
+
+	uint64_t head 	= head_.load(std::memory_order_acquire);
+	uint32_t offset = (uint32_t)tail & mask_;
+
+	*data = buffer_ + offset;
+	return std::min((uint32_t)(head - tail), capacity_ - offset);
+}
+
+void RingBuffer::consume(uint32_t length)
+{
+	uint64_t head = head_.load(std::memory_order_acquire);
+	tail_.store(std::min(tail_.load(std::memory_order_relaxed) + length, head), std::memory_order_release);
+}
+
+void RingBuffer::clear()
+{
+	tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+uint32_t RingBuffer::size()
+{
+	// Load the tail first, the head can only move further away from it. Stale bytes are not readable.
+	uint64_t tail = std::max(tail_.load(std::memory_order_acquire), stale_head_.load(std::memory_order_acquire));
+	uint64_t head = head_.load(std::memory_order_acquire);
+	return (uint32_t)(head - tail);
+}
+
+uint32_t RingBuffer::capacity()
+{
+	return capacity_;
+}
+
+bool RingBuffer::empty()
+{
+	return size() == 0;
+}
+
+uint64_t RingBuffer::get_overflow_bytes()
+{
+	return overflow_bytes_.load(std::memory_order_relaxed);
+}
+
+uint64_t RingBuffer::get_overflow_count()
+{
+	return overflow_count_.load(std::memory_order_relaxed);
+}
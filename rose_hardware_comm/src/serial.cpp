@@ -14,17 +14,41 @@
 
 #include "rose_hardware_comm/serial.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
+SerialEvent::SerialEvent()
+	: fd(eventfd(0, EFD_NONBLOCK))
+{}
+
+SerialEvent::~SerialEvent()
+{
+	if(fd >= 0)
+		close(fd);
+}
+
 Serial::Serial()
+	: happy_(false)
+	, was_connected_(false)
+	, read_buffer_(new RingBuffer(SERIAL_READ_BUFFER_SIZE))
+	, read_thread_spawned_(false)
+	, read_mode_(SERIAL_READ_MODE_POLLING)
+	, stop_event_fd_(-1)
+	, data_event_(new SerialEvent())
 {}
 
-Serial::Serial(string parent_name, string port, uint baudrate) 
+Serial::Serial(string parent_name, string port, uint baudrate, SerialReadMode read_mode) 
 	: HardwareComm()
 	, port_(port)
 	, baudrate_(baudrate)
-	, read_thread_spawned_(false)
 	, happy_(false)
+	, was_connected_(false)
+	, read_buffer_(new RingBuffer(SERIAL_READ_BUFFER_SIZE))
+	, read_thread_spawned_(false)
+	, read_mode_(read_mode)
+	, stop_event_fd_(-1)
+	, data_event_(new SerialEvent())
 {
 	ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Serial communication object constructed");
 	set_type(parent_name + "_serial_controller");	
@@ -41,6 +65,24 @@ bool Serial::is_ok()
 	return happy_; 
 }
 
+bool Serial::set_read_mode(SerialReadMode read_mode)
+{
+	// The read mode can only be changed while the read loop is not running
+	if(read_thread_spawned_)
+	{
+		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Cannot change read mode of serial connection [%s:%d] while connected.", port_.c_str(), baudrate_);
+		return false;
+	}
+
+	read_mode_ = read_mode;
+	return true;
+}
+
+SerialReadMode Serial::get_read_mode()
+{
+	return read_mode_;
+}
+
 bool Serial::connect()
 {
 	// Return true immediatly if already opened and happy
@@ -93,6 +135,9 @@ bool Serial::connect()
 
 	happy_ = true;
   	set_connected(true);
+	if(was_connected_)
+		counters_->n_reconnects.fetch_add(1, std::memory_order_relaxed);
+	was_connected_ = true;
   	ROS_DEBUG_NAMED(ROS_NAME_SERIAL,"Attibutes of serial connection [%s:%d] set.", port_.c_str(), baudrate_);
 
   	spawnReadloop();
@@ -128,6 +173,7 @@ bool Serial::read(char *byte)
 
 	long nread;
 	nread = ::read(file_descriptor_, byte, 1);
+	counters_->countRead(nread);
 	if (nread < 0)
 	{
 		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Read of serial connection [%s:%d] failed.", port_.c_str(), baudrate_);
@@ -144,6 +190,7 @@ int Serial::readBlock(char* block, uint32_t max_read_len)
     	return false;
 
   	long nread = ::read(file_descriptor_, block, (size_t)max_read_len);
+	counters_->countRead(nread);
   	if (nread < 0)
 	{
 		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Block read serial connection [%s:%d] failed.", port_.c_str(), baudrate_);
@@ -160,7 +207,14 @@ bool Serial::write(const char byte)
 	if(!isConnected())
 		return false;
 
-	if (file_descriptor_ >= 0 && ::write(file_descriptor_, &byte, 1) < 0)
+	long n_written = 0;
+	if (file_descriptor_ >= 0)
+	{
+		n_written = ::write(file_descriptor_, &byte, 1);
+		counters_->countWrite(n_written, 1);
+	}
+
+	if (n_written < 0)
 	{
 		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Byte write on serial connection [%s:%d] failed.", port_.c_str(), baudrate_);
 		happy_ = false;
@@ -177,14 +231,36 @@ bool Serial::writeBlock(const char *block, uint32_t block_len)
 	if(!isConnected())
 		return false;
 
-	if (file_descriptor_ >= 0 && ::write(file_descriptor_, block, block_len) < 0)
+	// The port is non-blocking, a large block can be written partially, continue when the port becomes writable again.
+	// The output queue is not flushed afterwards, that would discard the bytes not yet transmitted.
+	uint32_t written = 0;
+	while(written < block_len)
 	{
-		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Block write on serial connection [%s:%d] failed.", port_.c_str(), baudrate_);
-		happy_ = false;
-		disconnect();
-		return false;
-  	}
-  	tcflush(file_descriptor_, TCOFLUSH);
+		long n_written = ::write(file_descriptor_, block + written, block_len - written);
+		counters_->countWrite(n_written, block_len - written);
+		if(n_written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		{
+			struct pollfd poll_fd;
+			poll_fd.fd 		= file_descriptor_;
+			poll_fd.events 	= POLLOUT;
+			counters_->n_poll_calls.fetch_add(1, std::memory_order_relaxed);
+			if(poll(&poll_fd, 1, SERIAL_WRITE_TIMEOUT) > 0)
+				continue;
+		}
+		else if(n_written < 0 && errno == EINTR)
+			continue;
+
+		if(n_written < 0)
+		{
+			ROS_WARN_NAMED(ROS_NAME_SERIAL, "Block write on serial connection [%s:%d] failed.", port_.c_str(), baudrate_);
+			happy_ = false;
+			disconnect();
+			return false;
+		}
+
+		written += n_written;
+	}
+
 	return true;
 }
 
@@ -213,28 +289,92 @@ bool Serial::writeBlockSlow(const char *block, uint32_t block_len)
 
 bool Serial::fetchBuffer(thread_safe::deque<char>* buffer)
 {
-	if(!read_buffer_.empty())
+	if(read_buffer_->empty())
+		return false;
+
+	// Copy the readable spans, the data can wrap around so this takes at most two passes
+	buffer->clear();
+	const char* span;
+	uint32_t 	span_length;
+	while((span_length = read_buffer_->peek(&span)) > 0)
 	{
-		// Copy, return the copy and clear the thread_safe::read_buffer
-		buffer_mutex_->lock(); 
-		*buffer = read_buffer_;
-		read_buffer_.clear();
-		buffer_mutex_->unlock(); 
-
-		string buffer_string = "";
-		for(auto it = buffer->begin(); it != buffer->end(); it++)
-			buffer_string += *it;
-		
-		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Fetching serial read buffer %s", buffer_string.c_str());
+		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Fetching serial read buffer %s", string(span, span_length).c_str());
+		buffer->insert(buffer->end(), span, span + span_length);
+		read_buffer_->consume(span_length);
+	}
+
+	return true;
+}
+
+uint32_t Serial::borrowBuffer(const char** data)
+{
+	return read_buffer_->peek(data);
+}
+
+void Serial::commitBuffer(uint32_t n_consumed)
+{
+	read_buffer_->consume(n_consumed);
+}
+
+bool Serial::waitForData(uint32_t timeout)
+{
+	if(!read_buffer_->empty())
 		return true;
-	}	
-	return false;
+
+	if(data_event_->fd < 0)
+	{
+		usleep(std::min<uint32_t>(timeout, HARDWARE_COMM_DUMMY_WAIT));
+		return false;
+	}
+
+	// The event counter stays set when data was buffered after the check above, so no wake up is lost
+	struct pollfd poll_fd;
+	poll_fd.fd 		= data_event_->fd;
+	poll_fd.events 	= POLLIN;
+
+	struct timespec poll_timeout;
+	poll_timeout.tv_sec 	= timeout / 1000000;
+	poll_timeout.tv_nsec 	= (timeout % 1000000) * 1000;
+
+	counters_->n_poll_calls.fetch_add(1, std::memory_order_relaxed);
+	if(ppoll(&poll_fd, 1, timeout == HARDWARE_COMM_WAIT_FOREVER ? NULL : &poll_timeout, NULL) <= 0)
+		return false;
+
+	// Reset the event counter
+	uint64_t n_events;
+	if(::read(data_event_->fd, &n_events, sizeof(n_events)) < 0)
+		return false;
+
+	return true;
 }
 
+// Sets the data event as if bytes had been buffered
+void Serial::interruptWait()
+{
+	uint64_t one = 1;
+	if(data_event_->fd >= 0 && ::write(data_event_->fd, &one, sizeof(one)) < 0)
+		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Could not signal data event of serial connection [%s:%d].", port_.c_str(), baudrate_);
+}
 
+bool Serial::isReadExternally()
+{
+	return read_mode_ == SERIAL_READ_MODE_EXTERNAL;
+}
+
+int Serial::getPollDescriptor()
+{
+	if(!isReadExternally() || !isConnected())
+		return -1;
+
+	return file_descriptor_;
+}
 
 bool Serial::spawnReadloop()
 {
+	// The owner reads from the port
+	if(read_mode_ == SERIAL_READ_MODE_EXTERNAL)
+		return true;
+
 	if(read_thread_spawned_ == true)
 	{
 		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Serial read loop already spawned.");
@@ -243,13 +383,33 @@ bool Serial::spawnReadloop()
 	else	
 	{
 		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Spawning readLoop");
-		buffer_mutex_ 			= boost::shared_ptr<mutex>(new mutex());
 		stop_read_loop_mutex_	= boost::shared_ptr<mutex>(new mutex());
 
+		// Bytes of an earlier connection are not about the new one. The consumer can have a span borrowed, it drops
+		// them itself. No read thread runs, this thread is the producer until it is spawned.
+		read_buffer_->discardWritten();
+
 		stop_read_loop_mutex_->lock();
 		stop_read_loop_ 		= false;
 		stop_read_loop_mutex_->unlock();
 
+		if(read_mode_ == SERIAL_READ_MODE_EVENT)
+		{
+			stop_event_fd_ = eventfd(0, EFD_NONBLOCK);
+			if(stop_event_fd_ < 0)
+			{
+				ROS_WARN_NAMED(ROS_NAME_SERIAL, "Could not create stop event for serial connection [%s:%d]: %s, falling back to polling.", port_.c_str(), baudrate_, strerror(errno));
+				read_mode_ = SERIAL_READ_MODE_POLLING;
+			}
+		}
+
+		// Events of an earlier connection are not about the new one
+		uint64_t n_events;
+		if(data_event_->fd < 0)
+			ROS_WARN_NAMED(ROS_NAME_SERIAL, "No data event for serial connection [%s:%d], waiting for data polls.", port_.c_str(), baudrate_);
+		else if(::read(data_event_->fd, &n_events, sizeof(n_events)) < 0 && errno != EAGAIN)
+			ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Could not reset data event of serial connection [%s:%d].", port_.c_str(), baudrate_);
+
 		read_thread_ 			= boost::shared_ptr<thread>(new thread(&Serial::readLoop, this));
 		read_thread_spawned_ 	= true;
 	}
@@ -259,16 +419,30 @@ bool Serial::spawnReadloop()
 
 void Serial::stopReadloop()
 {
-	if(stop_read_loop_mutex_ == NULL)
+	if(stop_read_loop_mutex_ == NULL || read_thread_spawned_ == false)
 		return;
 
 	stop_read_loop_mutex_->lock();
 	stop_read_loop_ 		= true;
 	stop_read_loop_mutex_->unlock();
 
+	// Wake up the read loop if it is sleeping in poll()
+	if(stop_event_fd_ >= 0)
+	{
+		uint64_t one = 1;
+		if(::write(stop_event_fd_, &one, sizeof(one)) < 0)
+			ROS_WARN_NAMED(ROS_NAME_SERIAL, "Could not signal stop event of serial connection [%s:%d].", port_.c_str(), baudrate_);
+	}
+
 	read_thread_->join();
 	read_thread_spawned_ = false;
 
+	if(stop_event_fd_ >= 0)
+	{
+		close(stop_event_fd_);
+		stop_event_fd_ = -1;
+	}
+
 	stop_read_loop_mutex_->lock();
 	stop_read_loop_ 		= false;
 	stop_read_loop_mutex_->unlock();
@@ -277,12 +451,18 @@ void Serial::stopReadloop()
 // Call this with a separate thread
 void Serial::readLoop()
 {
-	buffer_mutex_->lock();
-	read_buffer_.clear();
-	buffer_mutex_->unlock();
+	if(read_mode_ == SERIAL_READ_MODE_EVENT)
+		eventReadLoop();
+	else
+		pollingReadLoop();
+
+	ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Stopping serial readloop");
+}
 
-	char character;
-	char character_buffer[100];
+// Wakes every SERIAL_POLL_INTERVAL and does a non-blocking read
+void Serial::pollingReadLoop()
+{
+	char character_buffer[SERIAL_READ_BLOCK_SIZE];
 	bool local_stop_read_loop_ = false;
 	while(isConnected() && !local_stop_read_loop_)		
 	{
@@ -290,22 +470,81 @@ void Serial::readLoop()
 		local_stop_read_loop_ = stop_read_loop_;
 		stop_read_loop_mutex_->unlock();
 
-		int n_read = readBlock(&character_buffer[0], 100);
+		int n_read = readBlock(&character_buffer[0], SERIAL_READ_BLOCK_SIZE);
 		if(n_read >= 0)
+			bufferBytes(character_buffer, n_read);
+
+		usleep(SERIAL_POLL_INTERVAL);
+	}
+}
+
+// Sleeps in poll() until the port becomes readable or the stop event is signalled
+void Serial::eventReadLoop()
+{
+	char character_buffer[SERIAL_READ_BLOCK_SIZE];
+
+	struct pollfd poll_fds[2];
+	poll_fds[0].fd 		= file_descriptor_;
+	poll_fds[0].events 	= POLLIN;
+	poll_fds[1].fd 		= stop_event_fd_;
+	poll_fds[1].events 	= POLLIN;
+
+	while(isConnected())		
+	{
+		counters_->n_poll_calls.fetch_add(1, std::memory_order_relaxed);
+		if(poll(poll_fds, 2, -1) < 0)
 		{
-			ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "%d char's received", n_read);
+			if(errno == EINTR)
+				continue;
+
+			ROS_WARN_NAMED(ROS_NAME_SERIAL, "Polling serial connection [%s:%d] failed: %s", port_.c_str(), baudrate_, strerror(errno));
+			happy_ = false;
+			break;
+		}
+
+		// Stop requested
+		if(poll_fds[1].revents & POLLIN)
+			break;
 
-			buffer_mutex_->lock();
-			for(int i = 0; i < n_read; i++)
+		// A hung up tty, for example an unplugged USB adapter, is also reported readable
+		if(poll_fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+		{
+			ROS_WARN_NAMED(ROS_NAME_SERIAL, "Serial connection [%s:%d] hung up.", port_.c_str(), baudrate_);
+			happy_ = false;
+			break;
+		}
+
+		if(poll_fds[0].revents & POLLIN)
+		{
+			// Readable without any byte to read is end of file, the port hung up
+			int n_read = readBlock(&character_buffer[0], SERIAL_READ_BLOCK_SIZE);
+			if(n_read <= 0)
 			{
-				ROS_DEBUG_NAMED(ROS_NAME_SERIAL, " %c", character_buffer[i]);
-				read_buffer_.push_back(character_buffer[i]); 
+				ROS_WARN_NAMED(ROS_NAME_SERIAL, "Serial connection [%s:%d] hung up.", port_.c_str(), baudrate_);
+				happy_ = false;
+				break;
 			}
-			buffer_mutex_->unlock();
+
+			bufferBytes(character_buffer, n_read);
 		}
-		usleep(100);
 	}
-	ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Stopping serial readloop");
+}
+
+void Serial::bufferBytes(const char* bytes, int n_bytes)
+{
+	ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "%d char's received", n_bytes);
+
+	if(n_bytes == 0)
+		return;
+
+	if(read_buffer_->write(bytes, n_bytes) < (uint32_t)n_bytes)
+		ROS_WARN_NAMED(ROS_NAME_SERIAL, "Read buffer of serial connection [%s:%d] overflowed, %lu bytes dropped in total.", port_.c_str(), baudrate_, (unsigned long)read_buffer_->get_overflow_bytes());
+	counters_->countBuffered(read_buffer_->size());
+
+	// Wake up a consumer waiting in waitForData()
+	uint64_t one = 1;
+	if(data_event_->fd >= 0 && ::write(data_event_->fd, &one, sizeof(one)) < 0)
+		ROS_DEBUG_NAMED(ROS_NAME_SERIAL, "Could not signal data event of serial connection [%s:%d].", port_.c_str(), baudrate_);
 }
 
 
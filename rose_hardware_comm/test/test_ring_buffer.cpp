@@ -0,0 +1,156 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Unit tests of the single-producer/single-consumer ring buffer.
+*
+***********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "rose_hardware_comm/ring_buffer.hpp"
+
+// Consumes all readable bytes, in as many spans as peek() returns
+static std::string readAll(RingBuffer& ring_buffer)
+{
+	std::string read;
+	const char* data;
+	uint32_t 	length;
+	while((length = ring_buffer.peek(&data)) > 0)
+	{
+		read.append(data, length);
+		ring_buffer.consume(length);
+	}
+	return read;
+}
+
+TEST(RingBuffer, RoundsCapacityUpToPowerOfTwo)
+{
+	RingBuffer ring_buffer(100);
+	EXPECT_EQ(128u, ring_buffer.capacity());
+	EXPECT_TRUE(ring_buffer.empty());
+}
+
+TEST(RingBuffer, ReadsWrittenBytesInOrder)
+{
+	RingBuffer ring_buffer(16);
+	EXPECT_EQ(5u, ring_buffer.write("hello", 5));
+	EXPECT_EQ(6u, ring_buffer.write(" world", 6));
+	EXPECT_EQ(11u, ring_buffer.size());
+	EXPECT_EQ("hello world", readAll(ring_buffer));
+	EXPECT_TRUE(ring_buffer.empty());
+}
+
+TEST(RingBuffer, SplitsWrappedDataInTwoSpans)
+{
+	RingBuffer ring_buffer(8);
+	ring_buffer.write("abcdef", 6);
+	ring_buffer.consume(6);
+	ring_buffer.write("ghijk", 5);
+
+	const char* data;
+	ASSERT_EQ(2u, ring_buffer.peek(&data));
+	EXPECT_EQ("gh", std::string(data, 2));
+	ring_buffer.consume(2);
+	ASSERT_EQ(3u, ring_buffer.peek(&data));
+	EXPECT_EQ("ijk", std::string(data, 3));
+}
+
+TEST(RingBuffer, CountsOverflow)
+{
+	RingBuffer ring_buffer(8);
+	EXPECT_EQ(8u, ring_buffer.write("0123456789", 10));
+	EXPECT_EQ(0u, ring_buffer.write("x", 1));
+	EXPECT_EQ(3u, ring_buffer.get_overflow_bytes());
+	EXPECT_EQ(2u, ring_buffer.get_overflow_count());
+	EXPECT_EQ("01234567", readAll(ring_buffer));
+}
+
+TEST(RingBuffer, ConsumesAtMostUpToWritePosition)
+{
+	RingBuffer ring_buffer(8);
+	ring_buffer.write("abc", 3);
+	ring_buffer.consume(5);
+	EXPECT_TRUE(ring_buffer.empty());
+
+	ring_buffer.write("de", 2);
+	EXPECT_EQ("de", readAll(ring_buffer));
+}
+
+TEST(RingBuffer, SkipsDiscardedBytes)
+{
+	RingBuffer ring_buffer(16);
+	ring_buffer.write("stale", 5);
+	ring_buffer.discardWritten();
+	EXPECT_TRUE(ring_buffer.empty());
+
+	ring_buffer.write("fresh", 5);
+	EXPECT_EQ(5u, ring_buffer.size());
+	EXPECT_EQ("fresh", readAll(ring_buffer));
+}
+
+TEST(RingBuffer, KeepsBorrowedSpanValidAfterDiscard)
+{
+	RingBuffer ring_buffer(16);
+	ring_buffer.write("old", 3);
+
+	const char* data;
+	ASSERT_EQ(3u, ring_buffer.peek(&data));
+	ring_buffer.discardWritten();
+	ring_buffer.write("new", 3);
+	EXPECT_EQ("old", std::string(data, 3));
+
+	ring_buffer.consume(3);
+	EXPECT_EQ("new", readAll(ring_buffer));
+}
+
+TEST(RingBuffer, TransfersBetweenThreads)
+{
+	const uint32_t 	n_bytes = 1 << 18;
+	RingBuffer 		ring_buffer(256);
+
+	std::thread producer([&]()
+	{
+		// The part of a block that does not fit is dropped, it is written again until it fits
+		char 		block[100];
+		uint32_t 	written = 0;
+		while(written < n_bytes)
+		{
+			uint32_t length = std::min((uint32_t)sizeof(block), n_bytes - written);
+			for(uint32_t i = 0; i < length; i++)
+				block[i] = (char)(written + i);
+			written += ring_buffer.write(block, length);
+			std::this_thread::yield();
+		}
+	});
+
+	uint32_t 	n_read 		= 0;
+	bool 		in_order 	= true;
+	while(n_read < n_bytes)
+	{
+		const char* data;
+		uint32_t 	length = ring_buffer.peek(&data);
+		for(uint32_t i = 0; i < length; i++)
+			in_order = in_order && data[i] == (char)(n_read + i);
+		ring_buffer.consume(length);
+		n_read += length;
+		std::this_thread::yield();
+	}
+
+	producer.join();
+	EXPECT_TRUE(in_order);
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Runs a number of concurrent startup like command sequences against a pseudo
+* 	terminal that answers like a low-level controller. Compares one blocking
+* 	thread per sequence with coroutines on a single executor thread, reporting
+* 	the threads used and the sequences/s.
+*
+***********************************************************************************/
+
+#include <pty.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rose_hardware_controller/command_coroutine.hpp"
+
+#define BENCHMARK_SEQUENCES_PER_RUN		512
+#define BENCHMARK_MAX_CONCURRENCY		256
+
+using namespace std;
+
+// Answers the id, version and watchdog treshold commands
+void controllerPeer(int master_fd)
+{
+	string 	frame;
+	char 	buffer[256];
+	ssize_t n;
+	while((n = ::read(master_fd, buffer, sizeof(buffer))) > 0)
+	{
+		for(ssize_t i = 0; i < n; i++)
+		{
+			if(buffer[i] == '$')
+				frame.clear();
+			else if(buffer[i] != '\r')
+				frame += buffer[i];
+			else
+			{
+				string response;
+				if(frame == "100,")
+					response = "$100,1,\r";
+				else if(frame == "101,")
+					response = "$101,1,0,\r";
+				else
+					response = "$" + frame + "\r";
+
+				if(::write(master_fd, response.data(), response.size()) < 0)
+					return;
+			}
+		}
+	}
+}
+
+bool blockingSequence(HardwareController<Serial>& controller)
+{
+	ControllerIdCommand::Response 			id;
+	FirmwareVersionCommand::Response 		version;
+	SetWatchdogTresholdCommand::Response 	treshold;
+	return 	controller.executeTyped<ControllerIdCommand>(ControllerIdCommand::Request(), id) &&
+			controller.executeTyped<FirmwareVersionCommand>(FirmwareVersionCommand::Request(), version) &&
+			controller.executeTyped<SetWatchdogTresholdCommand>(SetWatchdogTresholdCommand::Request(1000), treshold);
+}
+
+CommandTask<bool> coroutineSequence(HardwareController<Serial>& controller, CommandExecutor& executor)
+{
+	ControllerIdCommand::Response 			id;
+	FirmwareVersionCommand::Response 		version;
+	SetWatchdogTresholdCommand::Response 	treshold;
+	co_return 	(co_await awaitTyped<ControllerIdCommand>(controller, ControllerIdCommand::Request(), id, executor)).success &&
+				(co_await awaitTyped<FirmwareVersionCommand>(controller, FirmwareVersionCommand::Request(), version, executor)).success &&
+				(co_await awaitTyped<SetWatchdogTresholdCommand>(controller, SetWatchdogTresholdCommand::Request(1000), treshold, executor)).success;
+}
+
+// Runs BENCHMARK_SEQUENCES_PER_RUN sequences with at most concurrency of them in flight
+void benchmark(HardwareController<Serial>& controller, int concurrency)
+{
+	atomic<int> n_ok(0);
+
+	// Blocking, one thread per sequence in flight
+	auto start = chrono::steady_clock::now();
+	vector<thread> threads;
+	for(int i = 0; i < concurrency; i++)
+	{
+		threads.push_back(thread([&controller, &n_ok, concurrency]()
+		{
+			for(int j = 0; j < BENCHMARK_SEQUENCES_PER_RUN / concurrency; j++)
+				n_ok += blockingSequence(controller);
+		}));
+	}
+	for(auto& thread : threads)
+		thread.join();
+	double blocking_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	int blocking_ok = n_ok.exchange(0);
+
+	// Coroutines, all on one executor thread
+	CommandExecutor executor(1);
+	start = chrono::steady_clock::now();
+	for(int j = 0; j < BENCHMARK_SEQUENCES_PER_RUN / concurrency; j++)
+	{
+		vector< CommandTask<bool> > tasks;
+		for(int i = 0; i < concurrency; i++)
+			tasks.push_back(coroutineSequence(controller, executor));
+		for(auto& task : tasks)
+			n_ok += task.get();
+	}
+	double coroutine_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	printf("concurrency %4d  blocking: %4d threads %8.0f seq/s (%d ok)  coroutines: %lu thread %8.0f seq/s (%d ok)\n",
+			concurrency,
+			concurrency, blocking_ok / blocking_time, blocking_ok,
+			executor.get_nr_of_threads(), n_ok.load() / coroutine_time, n_ok.load());
+}
+
+int main(int argc, char** argv)
+{
+	int master_fd, slave_fd;
+	char slave_name[256];
+	if(openpty(&master_fd, &slave_fd, slave_name, NULL, NULL) < 0)
+	{
+		printf("Could not open pseudo terminal: %s\n", strerror(errno));
+		return 1;
+	}
+
+	struct termios settings;
+	tcgetattr(master_fd, &settings);
+	cfmakeraw(&settings);
+	tcsetattr(master_fd, TCSANOW, &settings);
+
+	thread peer(controllerPeer, master_fd);
+	peer.detach();
+
+	HardwareController<Serial> controller("benchmark", Serial("benchmark", slave_name, B115200, SERIAL_READ_MODE_EVENT));
+	if(!controller.get_comm_interface()->connect() || !controller.spawnReadloop())
+		return 1;
+
+	// Every sequence in flight queues a command
+	controller.set_queue_limit(COMMAND_PRIORITY_CONTROL, BENCHMARK_MAX_CONCURRENCY);
+	for(int concurrency : {1, 8, 64, BENCHMARK_MAX_CONCURRENCY})
+		benchmark(controller, concurrency);
+
+	controller.stopReadloop();
+	return 0;
+}
@@ -0,0 +1,238 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Measures what executeCommand() costs end to end, from a HardwareController
+* 	over a pseudo terminal to a simulated controller in a forked process. Sweeps
+* 	the emulated baud rate, the frame format, the number of data items per command
+* 	and the number of threads calling executeCommand() at the same time. Reports commands/s, the
+* 	p50/p99/p99.9 round trip and the CPU time per command of the controller side,
+* 	and writes them as CSV to the file given as argument.
+*
+* 	end_to_end_benchmark [<output file>]
+*
+***********************************************************************************/
+
+#include <signal.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "rose_hardware_controller/controller_simulator.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define BENCHMARK_DURATION			1000	// [ms] Per configuration
+#define BENCHMARK_ECHO_COMMAND		200		// Answered with the data items of the command
+#define BENCHMARK_DEFAULT_OUTPUT	"end_to_end_benchmark.csv"
+#define FORMAT_NAME(format)			((format) == FRAME_FORMAT_ASCII ? "ascii" : "binary")
+
+using namespace std;
+
+// 0 is a pseudo terminal without emulated line rate
+const int 		g_baudrates[] 		= {0, 921600, 460800, 115200};
+const FrameFormat 	g_frame_formats[] 	= {FRAME_FORMAT_ASCII, FRAME_FORMAT_BINARY};
+const int 		g_payload_sizes[] 	= {1, 16, 128};
+const int 		g_nr_of_callers[] 	= {1, 2, 4, 8};
+
+struct Result
+{
+	uint64_t 	n_commands;
+	uint64_t 	n_failed;
+	double 		duration; 		// [s]
+	double 		cpu; 			// [us]
+	double 		p50;			// [us]
+	double 		p99;
+	double 		p999;
+	double 		max;
+};
+
+// Hosts a simulator per baud rate, writes their ports to the pipe and runs until it is killed
+void simulatorHost(int pipe_fd)
+{
+	vector< boost::shared_ptr<ControllerSimulator> > simulators;
+	for(auto baudrate : g_baudrates)
+	{
+		SimulatorConfig config;
+		config.baudrate 		= baudrate;
+		config.binary_frames 	= true;
+
+		boost::shared_ptr<ControllerSimulator> simulator(new ControllerSimulator(config));
+		simulator->set_handler(BENCHMARK_ECHO_COMMAND, [](int, const vector<int>& request, vector<int>& response)
+		{
+			response = request;
+			return true;
+		});
+
+		if(!simulator->start())
+			_exit(1);
+
+		string port = simulator->get_port_name() + "\n";
+		if(::write(pipe_fd, port.data(), port.size()) < 0)
+			_exit(1);
+		simulators.push_back(simulator);
+	}
+
+	while(true)
+		pause();
+}
+
+double percentile(const vector<double>& sorted, double fraction)
+{
+	if(sorted.empty())
+		return 0.0;
+
+	return sorted[min(sorted.size() - 1, (size_t)(fraction * sorted.size()))];
+}
+
+void caller(HardwareController<Serial>* controller, int payload_size, chrono::steady_clock::time_point end, vector<double>* latencies, atomic<uint64_t>* n_failed)
+{
+	// The echoed data items are checked against the sent ones
+	ControllerResponse expected_response(number_codec::intToString(BENCHMARK_ECHO_COMMAND), HARDWARE_CONTROL_TIMEOUT);
+	ControllerCommand  command(number_codec::intToString(BENCHMARK_ECHO_COMMAND));
+	for(int i = 0; i < payload_size; i++)
+	{
+		expected_response.addExpectedDataItem(ControllerData(1000 + i, "Echo mismatch."));
+		command.addDataItem(1000 + i);
+	}
+	command.setExpectedResponse(expected_response);
+
+	while(chrono::steady_clock::now() < end)
+	{
+		auto start = chrono::steady_clock::now();
+		if(!controller->executeCommand(command))
+			(*n_failed)++;
+		latencies->push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+	}
+}
+
+bool benchmark(const string& port, FrameFormat frame_format, int payload_size, int nr_of_callers, Result* result)
+{
+	HardwareController<Serial> controller("benchmark", Serial("benchmark", port, B115200, SERIAL_READ_MODE_EXTERNAL));
+	if(!controller.get_comm_interface()->connect() || !controller.spawnReadloop() || !controller.negotiateFrameFormat(frame_format))
+		return false;
+
+	vector< vector<double> > 	latencies(nr_of_callers);
+	vector<thread> 				callers;
+	atomic<uint64_t> 			n_failed(0);
+
+	double 	cpu_start 	= cpuTime();
+	auto 	start 		= chrono::steady_clock::now();
+	auto 	end 		= start + chrono::milliseconds(BENCHMARK_DURATION);
+	for(int i = 0; i < nr_of_callers; i++)
+		callers.push_back(thread(caller, &controller, payload_size, end, &latencies[i], &n_failed));
+	for(auto& caller_thread : callers)
+		caller_thread.join();
+
+	result->duration 	= chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	result->cpu 		= (cpuTime() - cpu_start) * 1e6;
+
+	// The simulator keeps the frame format for the next connection
+	controller.negotiateFrameFormat(FRAME_FORMAT_ASCII);
+	controller.stopReadloop();
+	controller.get_comm_interface()->disconnect();
+
+	vector<double> all;
+	for(auto& caller_latencies : latencies)
+		all.insert(all.end(), caller_latencies.begin(), caller_latencies.end());
+	sort(all.begin(), all.end());
+
+	result->n_commands 	= all.size();
+	result->n_failed 	= n_failed;
+	result->p50 		= percentile(all, 0.5);
+	result->p99 		= percentile(all, 0.99);
+	result->p999 		= percentile(all, 0.999);
+	result->max 		= all.empty() ? 0.0 : all.back();
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const char* output_name = argc > 1 ? argv[1] : BENCHMARK_DEFAULT_OUTPUT;
+
+	// Fork before any thread is started, the simulators do not add to the measured CPU time
+	int pipe_fds[2];
+	if(pipe(pipe_fds) < 0)
+		return 1;
+
+	pid_t host = fork();
+	if(host == 0)
+	{
+		close(pipe_fds[0]);
+		simulatorHost(pipe_fds[1]);
+	}
+	close(pipe_fds[1]);
+
+	ros::init(argc, argv, "end_to_end_benchmark", ros::init_options::AnonymousName | ros::init_options::NoRosout);
+
+	vector<string> 	ports;
+	string 			line;
+	char 			character;
+	while(ports.size() < sizeof(g_baudrates) / sizeof(g_baudrates[0]) && ::read(pipe_fds[0], &character, 1) == 1)
+	{
+		if(character != '\n')
+			line += character;
+		else
+		{
+			ports.push_back(line);
+			line.clear();
+		}
+	}
+	close(pipe_fds[0]);
+
+	FILE* output = fopen(output_name, "w");
+	if(ports.size() != sizeof(g_baudrates) / sizeof(g_baudrates[0]) || output == NULL)
+	{
+		printf("Could not start the simulators or open %s.\n", output_name);
+		kill(host, SIGTERM);
+		waitpid(host, NULL, 0);
+		return 1;
+	}
+
+	fprintf(output, "baudrate,frame_format,payload_items,callers,commands,failed,duration_s,commands_per_s,p50_us,p99_us,p999_us,max_us,cpu_us_per_command\n");
+	printf("%8s %6s %6s %7s %10s %8s %10s %10s %10s %10s %8s\n", "baudrate", "format", "items", "callers", "commands/s", "failed", "p50 [us]", "p99 [us]", "p99.9 [us]", "max [us]", "cpu [us]");
+
+	bool ok = true;
+	for(size_t i = 0; i < ports.size(); i++)
+	{
+		for(auto frame_format : g_frame_formats)
+		{
+			for(auto payload_size : g_payload_sizes)
+			{
+				for(auto nr_of_callers : g_nr_of_callers)
+				{
+					Result result;
+					if(!benchmark(ports[i], frame_format, payload_size, nr_of_callers, &result))
+					{
+						ok = false;
+						continue;
+					}
+
+					double commands_per_second 	= result.n_commands / result.duration;
+					double cpu_per_command 		= result.n_commands > 0 ? result.cpu / result.n_commands : 0.0;
+
+					fprintf(output, "%d,%s,%d,%d,%lu,%lu,%.3f,%.1f,%.1f,%.1f,%.1f,%.1f,%.2f\n", g_baudrates[i], FORMAT_NAME(frame_format), payload_size, nr_of_callers,
+							(unsigned long)result.n_commands, (unsigned long)result.n_failed, result.duration, commands_per_second,
+							result.p50, result.p99, result.p999, result.max, cpu_per_command);
+					printf("%8d %6s %6d %7d %10.1f %8lu %10.1f %10.1f %10.1f %10.1f %8.2f\n", g_baudrates[i], FORMAT_NAME(frame_format), payload_size, nr_of_callers,
+							commands_per_second, (unsigned long)result.n_failed, result.p50, result.p99, result.p999, result.max, cpu_per_command);
+					fflush(stdout);
+				}
+			}
+		}
+	}
+
+	fclose(output);
+	kill(host, SIGTERM);
+	waitpid(host, NULL, 0);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compares the FrameParser with the character by character framing the
+* 	responsesReadloop used to do. Reports frames/s and heap allocations per frame
+* 	for watchdog responses and 1000 timer responses.
+* 
+***********************************************************************************/
+
+#include <stdio.h>
+
+#include <chrono>
+#include <deque>
+#include <string>
+
+#define BENCHMARK_COUNT_ALLOCATIONS
+#include "benchmark_utils.hpp"
+#include "rose_hardware_controller/controller_response.hpp"
+#include "rose_hardware_controller/frame_parser.hpp"
+
+#define BENCHMARK_STREAM_SIZE		(4 * 1024 * 1024)	// [bytes]
+#define BENCHMARK_READ_SIZE			100					// [bytes], same as SERIAL_READ_BLOCK_SIZE
+
+using namespace std;
+
+string makeStream(const string& frame)
+{
+	string stream;
+	while(stream.size() < BENCHMARK_STREAM_SIZE)
+		stream += frame;
+	return stream;
+}
+
+void report(const char* name, chrono::steady_clock::duration duration, uint64_t n_frames, uint64_t allocations)
+{
+	double seconds = chrono::duration<double>(duration).count();
+	printf("  %-10s %10.0f frames/s  %8.1f allocations/frame\n", name, n_frames / seconds, (double)allocations / n_frames);
+}
+
+// The framing as it was done in responsesReadloop, one ControllerResponse per delimiter and one string per character
+uint64_t legacyParse(const string& stream)
+{
+	uint64_t n_frames = 0;
+	deque<char> serial_buffer;
+	ControllerResponse* cur_response = new ControllerResponse();
+	string response;
+
+	for(size_t offset = 0; offset < stream.size(); offset += BENCHMARK_READ_SIZE)
+	{
+		serial_buffer.insert(serial_buffer.end(), stream.begin() + offset, stream.begin() + min(offset + BENCHMARK_READ_SIZE, stream.size()));
+		while(!serial_buffer.empty())
+		{
+			char cur_character = serial_buffer.front();
+			serial_buffer.pop_front();
+			switch(cur_character)
+			{
+				case '$':
+					delete cur_response;
+					cur_response = new ControllerResponse();
+					response = "";
+					break;
+				case '\n':
+				case '\r':
+					cur_response->set_response(response);
+					n_frames++;
+					delete cur_response;
+					cur_response = new ControllerResponse();
+					response = "";
+					break;
+				default:
+					response = response + cur_character;
+					break;
+			}
+		}
+	}
+	delete cur_response;
+	return n_frames;
+}
+
+uint64_t frameParserParse(const string& stream)
+{
+	uint64_t 			n_frames = 0;
+	FrameParser 		frame_parser;
+	ControllerResponse 	response;
+	bool 				frame_complete;
+
+	for(size_t offset = 0; offset < stream.size(); offset += BENCHMARK_READ_SIZE)
+	{
+		const char* data 		= stream.data() + offset;
+		uint32_t 	length 		= min((size_t)BENCHMARK_READ_SIZE, stream.size() - offset);
+		uint32_t 	n_parsed 	= 0;
+		while(n_parsed < length)
+		{
+			n_parsed += frame_parser.parse(data + n_parsed, length - n_parsed, &frame_complete);
+			if(frame_complete)
+			{
+				response.set_response(frame_parser.getFrame(), frame_parser.getFrameLength());
+				n_frames++;
+			}
+		}
+	}
+	return n_frames;
+}
+
+void benchmark(const char* name, const string& frame)
+{
+	string stream = makeStream(frame);
+	printf("%s (%lu bytes/frame)\n", name, frame.size());
+
+	uint64_t allocations 	= n_allocations;
+	auto start 				= chrono::steady_clock::now();
+	uint64_t n_frames 		= legacyParse(stream);
+	report("legacy", chrono::steady_clock::now() - start, n_frames, n_allocations - allocations);
+
+	allocations 			= n_allocations;
+	start 					= chrono::steady_clock::now();
+	n_frames 				= frameParserParse(stream);
+	report("parser", chrono::steady_clock::now() - start, n_frames, n_allocations - allocations);
+}
+
+int main(int argc, char** argv)
+{
+	benchmark("watchdog", "$111,1,2345,0,0,\r");
+
+	string timers = "$115,";
+	for(int i = 0; i < 1000; i++)
+		timers += "1000," + to_string(i) + ",";
+	timers += "\r";
+	benchmark("timers", timers);
+
+	return 0;
+}
@@ -0,0 +1,224 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Microbenchmarks of the per command hot paths: encoding a command or patching
+* 	its template, taking the data items out of a response, checking a response
+* 	and framing a stream of received bytes. Each case is repeated until it ran long enough to be timed
+* 	and reports ns/op and heap allocations/op, for watchdog, version and 1000
+* 	timer payloads.
+*
+***********************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define BENCHMARK_COUNT_ALLOCATIONS
+#include "benchmark_utils.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define BENCHMARK_MIN_TIME			200		// [ms] Minimum duration of a timed run
+#define BENCHMARK_MAX_ITERATIONS	(1 << 30)
+#define BENCHMARK_STREAM_SIZE		65536	// [bytes] Received bytes framed per op of the framing cases
+#define BENCHMARK_NR_OF_TIMERS		1000
+
+using namespace std;
+
+// Results are added to it such that the compiler can not drop the benchmarked code
+static volatile uint64_t sink;
+
+// Doubles the number of iterations until a run takes BENCHMARK_MIN_TIME, then reports that run
+template<class Function>
+void run(const char* name, Function function)
+{
+	for(uint64_t n_iterations = 1; ; n_iterations *= 2)
+	{
+		uint64_t 	checksum 	= 0;
+		uint64_t 	allocations = n_allocations;
+		auto 		start 		= chrono::steady_clock::now();
+		for(uint64_t i = 0; i < n_iterations; i++)
+			checksum += function();
+		auto 		duration 	= chrono::steady_clock::now() - start;
+		allocations 			= n_allocations - allocations;
+		sink 					= sink + checksum;
+
+		if(duration >= chrono::milliseconds(BENCHMARK_MIN_TIME) || n_iterations >= BENCHMARK_MAX_ITERATIONS)
+		{
+			printf("  %-32s %12.1f ns/op  %8.1f allocations/op  %10lu iterations\n", name,
+					chrono::duration<double, nano>(duration).count() / n_iterations, (double)allocations / n_iterations, (unsigned long)n_iterations);
+			return;
+		}
+	}
+}
+
+// The frames of the payloads, without '$' and '\r'
+struct Payload
+{
+	const char* 	name;
+	string 			command;
+	vector<int> 	command_data;
+	string 			response;
+	uint32_t 		nr_of_response_items;
+};
+
+vector<Payload> payloads()
+{
+	vector<Payload> payloads(3);
+
+	payloads[0].name 					= "watchdog";
+	payloads[0].command 				= HARDWARE_CONTROL_WATCHDOG;
+	payloads[0].command_data 			= vector<int>(1, 1);
+	payloads[0].response 				= "111,1,2345,0,0,";
+	payloads[0].nr_of_response_items 	= 4;
+
+	payloads[1].name 					= "version";
+	payloads[1].command 				= HARDWARE_CONTROL_VERSION;
+	payloads[1].response 				= "101,2,13,";
+	payloads[1].nr_of_response_items 	= 2;
+
+	payloads[2].name 					= "timers";
+	payloads[2].command 				= HARDWARE_CONTROL_GET_TIMERS;
+	payloads[2].response 				= "115,";
+	for(int i = 0; i < BENCHMARK_NR_OF_TIMERS; i++)
+		payloads[2].response += "1000," + to_string(i) + ",";
+	payloads[2].nr_of_response_items 	= 2 * BENCHMARK_NR_OF_TIMERS;
+
+	return payloads;
+}
+
+void benchmarkPayload(HardwareController<Serial>& controller, const Payload& payload)
+{
+	printf("%s (%lu response bytes)\n", payload.name, payload.response.size() + 2);
+
+	// Encoding
+	ControllerCommand command(payload.command);
+	for(auto value : payload.command_data)
+		command.addDataItem(value);
+
+	run("getSerialMessage", [&]()
+	{
+		return command.getSerialMessage().size();
+	});
+
+	// Patching the data items of a pre-encoded command instead
+	CommandTemplate command_template(command);
+	int 			patch = 0;
+	run("CommandTemplate patch", [&]()
+	{
+		patch++;
+		for(uint32_t i = 0; i < command_template.getNrOfDataItems(); i++)
+			command_template.set_data_item(i, patch);
+		return command_template.getMessageLength();
+	});
+
+	// Taking the data items out of a received response
+	run("set_response", [&]()
+	{
+		ControllerResponse response;
+		response.set_response(payload.response.data(), payload.response.size());
+		return response.getNrOfReceivedDataItems();
+	});
+
+	run("getReceivedDataItems", [&]()
+	{
+		ControllerResponse response;
+		response.set_response(payload.response.data(), payload.response.size());
+		return response.getReceivedDataItems().size();
+	});
+
+	// Checking a response against the command, every data item is assigned to a variable
+	vector<int> 		values(payload.nr_of_response_items);
+	ControllerResponse 	expected_response(payload.command, HARDWARE_CONTROL_TIMEOUT);
+	for(auto& value : values)
+		expected_response.addExpectedDataItem(ControllerData(value));
+	ControllerCommand 	checked_command(payload.command, expected_response);
+
+	ControllerResponse received_response;
+	received_response.set_response(payload.response.data(), payload.response.size());
+	run("checkResponse", [&]()
+	{
+		return controller.checkResponse(checked_command, received_response) + values.back();
+	});
+
+	CommandTemplate checking_template(checked_command);
+	run("CommandTemplate::checkResponse", [&]()
+	{
+		return checking_template.checkResponse(received_response) + values.back();
+	});
+
+	// Framing a stream of responses as the response read loop and the reactor do
+	string stream;
+	while(stream.size() < BENCHMARK_STREAM_SIZE)
+		stream += "$" + payload.response + "\r";
+
+	FrameParser 		frame_parser;
+	ControllerResponse 	framed_response;
+	run("framing per 64 KiB", [&]()
+	{
+		bool 		frame_complete;
+		uint64_t 	n_items = 0;
+		for(size_t offset = 0; offset < stream.size(); offset += HARDWARE_CONTROL_REACTOR_READ_SIZE)
+		{
+			const char* data 		= stream.data() + offset;
+			uint32_t 	length 		= min((size_t)HARDWARE_CONTROL_REACTOR_READ_SIZE, stream.size() - offset);
+			uint32_t 	n_parsed 	= 0;
+			while(n_parsed < length)
+			{
+				n_parsed += frame_parser.parse(data + n_parsed, length - n_parsed, &frame_complete);
+				if(frame_complete)
+				{
+					framed_response.set_response(frame_parser.getFrame(), frame_parser.getFrameLength());
+					n_items += framed_response.getNrOfReceivedDataItems();
+				}
+			}
+		}
+		return n_items;
+	});
+}
+
+void benchmarkTyped()
+{
+	printf("typed decode\n");
+
+	ControllerResponse watchdog_response;
+	watchdog_response.set_response("111,1,2345,0,0,");
+	run("WatchdogCommand::decode", [&]()
+	{
+		WatchdogCommand::Response response;
+		return WatchdogCommand::decode(watchdog_response, WatchdogCommand::Request(1), response) + std::get<1>(response);
+	});
+
+	string timers = "115,";
+	for(int i = 0; i < BENCHMARK_NR_OF_TIMERS; i++)
+		timers += "1000," + to_string(i) + ",";
+
+	ControllerResponse timers_response;
+	timers_response.set_response(timers);
+	GetTimersCommand::Response response;
+	run("GetTimersCommand::decode", [&]()
+	{
+		return GetTimersCommand::decode(timers_response, GetTimersCommand::Request(), response) + std::get<0>(response).size();
+	});
+}
+
+int main(int argc, char** argv)
+{
+	ros::init(argc, argv, "hot_path_benchmark", ros::init_options::AnonymousName | ros::init_options::NoRosout);
+
+	// Not connected, only used to check responses
+	HardwareController<Serial> controller;
+
+	for(auto& payload : payloads())
+		benchmarkPayload(controller, payload);
+
+	benchmarkTyped();
+	return 0;
+}
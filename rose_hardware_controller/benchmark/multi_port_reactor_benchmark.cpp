@@ -0,0 +1,179 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Serves up to 32 controllers, each on its own pseudo terminal, with a private
+* 	reactor per controller and with one shared reactor of 1 and 2 threads. A
+* 	forked process echoes the commands on all ports. Every controller keeps one
+* 	command in flight, reports the commands/s, the CPU time per command and the
+* 	number of I/O threads.
+*
+***********************************************************************************/
+
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define BENCHMARK_MAX_PORTS				32
+#define BENCHMARK_COMMANDS_PER_PORT		2000
+
+using namespace std;
+
+typedef boost::shared_ptr< HardwareController<Serial> > ControllerPtr;
+
+void echoPeer(const vector<int>& master_fds)
+{
+	vector<FrameEcho> 		echoes(master_fds.size());
+	vector<struct pollfd> 	poll_fds(master_fds.size());
+	for(size_t i = 0; i < master_fds.size(); i++)
+	{
+		poll_fds[i].fd 		= master_fds[i];
+		poll_fds[i].events 	= POLLIN;
+	}
+
+	char buffer[256];
+	while(poll(poll_fds.data(), poll_fds.size(), -1) > 0)
+	{
+		for(size_t port = 0; port < poll_fds.size(); port++)
+		{
+			if(!(poll_fds[port].revents & POLLIN))
+				continue;
+
+			ssize_t n = ::read(master_fds[port], buffer, sizeof(buffer));
+			if(!echoes[port].handle(master_fds[port], buffer, n))
+				return;
+		}
+	}
+}
+
+// Keeps one command in flight, the next one is submitted from the completion callback
+void commandChain(HardwareController<Serial>* controller, int remaining, atomic<int>* n_ok, promise<void>* done)
+{
+	ControllerResponse response("300", 1);
+	response.addExpectedDataItem(ControllerData(remaining, "Setting value unsuccessfull."));
+	ControllerCommand command("300", response);
+	command.addDataItem(remaining);
+	controller->executeCommandAsync(command, [=](const CommandResult& result)
+	{
+		*n_ok += result.success;
+		if(remaining > 1)
+			commandChain(controller, remaining - 1, n_ok, done);
+		else
+			done->set_value();
+	});
+}
+
+// A shared reactor with n_threads threads, or a private reactor per controller if n_threads is 0
+bool benchmark(const char* name, const vector<string>& ports, unsigned int n_threads)
+{
+	boost::shared_ptr<IoReactor> reactor;
+	if(n_threads > 0)
+		reactor = boost::shared_ptr<IoReactor>(new IoReactor(n_threads));
+
+	vector<ControllerPtr> controllers;
+	for(auto& port : ports)
+	{
+		ControllerPtr controller(new HardwareController<Serial>("benchmark", Serial("benchmark", port, B115200, SERIAL_READ_MODE_EXTERNAL)));
+		if(!controller->get_comm_interface()->connect())
+			return false;
+
+		if(!(reactor ? controller->attachReactor(reactor) : controller->spawnReadloop()))
+			return false;
+
+		controllers.push_back(controller);
+	}
+
+	// Excluding the main thread
+	int io_threads = nrOfThreads() - 1;
+
+	atomic<int> 			n_ok(0);
+	vector< promise<void> > done(controllers.size());
+
+	struct rusage start_usage, end_usage;
+	getrusage(RUSAGE_SELF, &start_usage);
+	auto start = chrono::steady_clock::now();
+
+	for(size_t i = 0; i < controllers.size(); i++)
+		commandChain(controllers[i].get(), BENCHMARK_COMMANDS_PER_PORT, &n_ok, &done[i]);
+	for(auto& chain : done)
+		chain.get_future().wait();
+
+	double duration = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	getrusage(RUSAGE_SELF, &end_usage);
+
+	double cpu = 	(end_usage.ru_utime.tv_sec - start_usage.ru_utime.tv_sec) * 1e6 + (end_usage.ru_utime.tv_usec - start_usage.ru_utime.tv_usec) +
+					(end_usage.ru_stime.tv_sec - start_usage.ru_stime.tv_sec) * 1e6 + (end_usage.ru_stime.tv_usec - start_usage.ru_stime.tv_usec);
+	int n_commands = controllers.size() * BENCHMARK_COMMANDS_PER_PORT;
+
+	printf("ports %2lu  %-10s I/O threads: %2d  %8.0f commands/s  cpu: %5.1f us per command (%d/%d ok)\n",
+			controllers.size(), name, io_threads, n_commands / duration, cpu / n_commands, n_ok.load(), n_commands);
+
+	for(auto& controller : controllers)
+	{
+		controller->stopReadloop();
+		controller->get_comm_interface()->disconnect();
+	}
+
+	return n_ok == n_commands;
+}
+
+int main(int argc, char** argv)
+{
+	vector<int> 	master_fds;
+	vector<int> 	slave_fds;
+	vector<string> 	ports;
+	for(int i = 0; i < BENCHMARK_MAX_PORTS; i++)
+	{
+		int master_fd, slave_fd;
+		char slave_name[256];
+		if(openpty(&master_fd, &slave_fd, slave_name, NULL, NULL) < 0)
+		{
+			printf("Could not open pseudo terminal: %s\n", strerror(errno));
+			return 1;
+		}
+
+		struct termios settings;
+		tcgetattr(master_fd, &settings);
+		cfmakeraw(&settings);
+		tcsetattr(master_fd, TCSANOW, &settings);
+
+		master_fds.push_back(master_fd);
+		slave_fds.push_back(slave_fd);
+		ports.push_back(slave_name);
+	}
+
+	// Fork before any thread is started
+	pid_t peer = fork();
+	if(peer == 0)
+	{
+		echoPeer(master_fds);
+		_exit(0);
+	}
+
+	bool ok = true;
+	for(size_t n_ports = 1; n_ports <= BENCHMARK_MAX_PORTS; n_ports *= 2)
+	{
+		vector<string> used_ports(ports.begin(), ports.begin() + n_ports);
+		ok = 	benchmark("private", used_ports, 0) &&
+				benchmark("shared 1", used_ports, 1) &&
+				benchmark("shared 2", used_ports, 2) && ok;
+	}
+
+	kill(peer, SIGTERM);
+	waitpid(peer, NULL, 0);
+	return ok ? 0 : 1;
+}
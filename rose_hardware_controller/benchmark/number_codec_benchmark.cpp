@@ -0,0 +1,110 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compares the number codec with rose_conversions::intToString/stringToInt on
+* 	typical watchdog and timer payloads.
+* 
+***********************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "rose_conversions/conversions.hpp"
+#include "rose_hardware_controller/number_codec.hpp"
+
+#define BENCHMARK_ITERATIONS		200
+
+using namespace std;
+
+void report(const char* name, chrono::steady_clock::duration duration, uint64_t n_values, int64_t checksum)
+{
+	printf("  %-24s %8.1f ns/value  (checksum %ld)\n", name, chrono::duration<double, nano>(duration).count() / n_values, (long)checksum);
+}
+
+void benchmark(const char* name, const vector<int>& values)
+{
+	printf("%s (%lu values)\n", name, values.size());
+
+	vector<string> strings;
+	for(auto value : values)
+		strings.push_back(rose_conversions::intToString(value));
+
+	int64_t checksum 	= 0;
+	auto start 			= chrono::steady_clock::now();
+	for(int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		for(auto value : values)
+			checksum += rose_conversions::intToString(value).length();
+	report("intToString", chrono::steady_clock::now() - start, BENCHMARK_ITERATIONS * values.size(), checksum);
+
+	checksum 	= 0;
+	start 		= chrono::steady_clock::now();
+	for(int i = 0; i < BENCHMARK_ITERATIONS; i++)
+	{
+		char 		buffer[NUMBER_CODEC_MAX_INT_LENGTH];
+		uint32_t 	length;
+		for(auto value : values)
+		{
+			number_codec::encodeInt(value, buffer, sizeof(buffer), &length);
+			checksum += length;
+		}
+	}
+	report("number_codec::encodeInt", chrono::steady_clock::now() - start, BENCHMARK_ITERATIONS * values.size(), checksum);
+
+	checksum 	= 0;
+	start 		= chrono::steady_clock::now();
+	for(int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		for(auto& string : strings)
+		{
+			try {
+				checksum += rose_conversions::stringToInt(string);
+			}
+			catch(...) {}
+		}
+	report("stringToInt", chrono::steady_clock::now() - start, BENCHMARK_ITERATIONS * values.size(), checksum);
+
+	checksum 	= 0;
+	start 		= chrono::steady_clock::now();
+	for(int i = 0; i < BENCHMARK_ITERATIONS; i++)
+		for(auto& string : strings)
+		{
+			int value;
+			if(number_codec::decodeInt(string.data(), string.length(), &value) == CODEC_OK)
+				checksum += value;
+		}
+	report("number_codec::decodeInt", chrono::steady_clock::now() - start, BENCHMARK_ITERATIONS * values.size(), checksum);
+}
+
+int main(int argc, char** argv)
+{
+	// Watchdog: toggle, counter and two unused fields
+	vector<int> watchdog;
+	for(int i = 0; i < 1000; i++)
+	{
+		watchdog.push_back(i % 2);
+		watchdog.push_back(i * 10);
+		watchdog.push_back(0);
+		watchdog.push_back(0);
+	}
+	benchmark("watchdog", watchdog);
+
+	// Timers: set and current value of 1000 timers
+	srand(0);
+	vector<int> timers;
+	for(int i = 0; i < 1000; i++)
+	{
+		timers.push_back(rand() % 100000);
+		timers.push_back(rand() % 100000);
+	}
+	benchmark("timers", timers);
+
+	return 0;
+}
@@ -0,0 +1,100 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compares the serial read thread plus response read loop with the single
+* 	reactor thread. A forked process echoes the commands on a pseudo terminal,
+* 	such that only the context switches of the controller side are counted.
+* 	Reports the round trip, the CPU time and the context switches per command.
+*
+***********************************************************************************/
+
+#include <pty.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define BENCHMARK_COMMANDS		5000
+
+using namespace std;
+
+void echoPeer(int master_fd)
+{
+	FrameEcho 	echo;
+	char 		buffer[256];
+	ssize_t 	n;
+	while((n = ::read(master_fd, buffer, sizeof(buffer))) > 0 && echo.handle(master_fd, buffer, n))
+	{}
+}
+
+bool benchmark(const char* name, const char* port, SerialReadMode read_mode)
+{
+	HardwareController<Serial> controller("benchmark", Serial("benchmark", port, B115200, read_mode));
+	if(!controller.get_comm_interface()->connect() || !controller.spawnReadloop())
+		return false;
+
+	int threads = nrOfThreads();
+
+	struct rusage start_usage, end_usage;
+	getrusage(RUSAGE_SELF, &start_usage);
+	auto start = chrono::steady_clock::now();
+
+	int n_ok = 0;
+	for(int i = 0; i < BENCHMARK_COMMANDS; i++)
+		n_ok += controller.setValue("300", 1, i);
+
+	double duration = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+	getrusage(RUSAGE_SELF, &end_usage);
+
+	double cpu = 	(end_usage.ru_utime.tv_sec - start_usage.ru_utime.tv_sec) * 1e6 + (end_usage.ru_utime.tv_usec - start_usage.ru_utime.tv_usec) +
+					(end_usage.ru_stime.tv_sec - start_usage.ru_stime.tv_sec) * 1e6 + (end_usage.ru_stime.tv_usec - start_usage.ru_stime.tv_usec);
+	long switches = (end_usage.ru_nvcsw - start_usage.ru_nvcsw) + (end_usage.ru_nivcsw - start_usage.ru_nivcsw);
+
+	printf("%-8s threads: %d  round trip: %7.1f us  cpu: %6.1f us  context switches: %5.2f per command (%d/%d ok)\n",
+			name, threads, duration / BENCHMARK_COMMANDS, cpu / BENCHMARK_COMMANDS, (double)switches / BENCHMARK_COMMANDS, n_ok, BENCHMARK_COMMANDS);
+
+	controller.stopReadloop();
+	controller.get_comm_interface()->disconnect();
+	return n_ok == BENCHMARK_COMMANDS;
+}
+
+int main(int argc, char** argv)
+{
+	int master_fd, slave_fd;
+	char slave_name[256];
+	if(openpty(&master_fd, &slave_fd, slave_name, NULL, NULL) < 0)
+	{
+		printf("Could not open pseudo terminal: %s\n", strerror(errno));
+		return 1;
+	}
+
+	struct termios settings;
+	tcgetattr(master_fd, &settings);
+	cfmakeraw(&settings);
+	tcsetattr(master_fd, TCSANOW, &settings);
+
+	// Fork before any thread is started
+	pid_t peer = fork();
+	if(peer == 0)
+	{
+		echoPeer(master_fd);
+		_exit(0);
+	}
+
+	bool ok = 	benchmark("polling", slave_name, SERIAL_READ_MODE_POLLING) &&
+				benchmark("event", slave_name, SERIAL_READ_MODE_EVENT) &&
+				benchmark("reactor", slave_name, SERIAL_READ_MODE_EXTERNAL);
+
+	kill(peer, SIGTERM);
+	waitpid(peer, NULL, 0);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Example of the startup sequence of a low-level controller written as a
+* 	coroutine: check the controller id, check the firmware version and set the
+* 	watchdog treshold, without blocking a thread while waiting for responses.
+* 	Usage: coroutine_startup_example <port> <controller id> <major> <minor>
+*
+***********************************************************************************/
+
+#include <stdlib.h>
+
+#include "rose_hardware_controller/command_coroutine.hpp"
+
+using namespace std;
+
+CommandTask<bool> startup(HardwareController<Serial>& controller, CommandExecutor& executor, int controller_id, int major_version, int minor_version)
+{
+	ControllerIdCommand::Response id;
+	if(!(co_await awaitTyped<ControllerIdCommand>(controller, ControllerIdCommand::Request(), id, executor)).success || std::get<0>(id) != controller_id)
+	{
+		ROS_ERROR("Invalid controller id, expected %d.", controller_id);
+		co_return false;
+	}
+
+	FirmwareVersionCommand::Response version;
+	if(!(co_await awaitTyped<FirmwareVersionCommand>(controller, FirmwareVersionCommand::Request(), version, executor)).success ||
+		std::get<0>(version) != major_version || std::get<1>(version) != minor_version)
+	{
+		ROS_ERROR("Invalid firmware version, expected %d.%d.", major_version, minor_version);
+		co_return false;
+	}
+
+	SetWatchdogTresholdCommand::Response treshold;
+	if(!(co_await awaitTyped<SetWatchdogTresholdCommand>(controller, SetWatchdogTresholdCommand::Request(HARDWARE_CONTROL_DEFAULT_WATCHDOG_TIMEOUT), treshold, executor)).success)
+	{
+		ROS_ERROR("Could not set the watchdog treshold.");
+		co_return false;
+	}
+
+	co_return true;
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 5)
+	{
+		printf("Usage: %s <port> <controller id> <major> <minor>\n", argv[0]);
+		return 1;
+	}
+
+	ros::init(argc, argv, "coroutine_startup_example");
+
+	HardwareController<Serial> controller("example", Serial("example", argv[1], B115200, SERIAL_READ_MODE_EVENT));
+	if(!controller.get_comm_interface()->connect() || !controller.spawnReadloop())
+		return 1;
+
+	CommandExecutor executor;
+	bool ok = startup(controller, executor, atoi(argv[2]), atoi(argv[3]), atoi(argv[4])).get();
+
+	ROS_INFO("Startup %s.", ok ? "succeeded" : "failed");
+	controller.stopReadloop();
+	return ok ? 0 : 1;
+}
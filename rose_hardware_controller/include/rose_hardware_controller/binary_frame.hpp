@@ -0,0 +1,72 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Binary frame format of the controller protocol, negotiated as alternative to
+* 	the '$type,item,...,\r' ASCII format. A message is a 16 bit type followed by
+* 	32 bit data items, all little-endian. A CRC-16 is appended and the whole is
+* 	COBS encoded, such that a zero byte delimits the frames.
+*
+***********************************************************************************/
+
+#ifndef BINARY_FRAME_HPP
+#define BINARY_FRAME_HPP
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#define BINARY_FRAME_DELIMITER		'\0'
+#define BINARY_FRAME_TYPE_SIZE		2		// [bytes]
+#define BINARY_FRAME_ITEM_SIZE		4		// [bytes]
+#define BINARY_FRAME_CRC_SIZE		2		// [bytes]
+
+namespace binary_frame
+{
+	//! @return The CRC-16/CCITT-FALSE of the data, polynomial 0x1021 and initial value 0xFFFF.
+	uint16_t 		crc16(const char* data, uint32_t length);
+
+	//! Appends the CRC, the COBS encoding and the delimiter of a message to a string.
+	void 			appendFrame(const char* message, uint32_t length, std::string& frame);
+
+	/**
+	 * Decodes a received frame in place, without its delimiter.
+	 * @param[out] uint32_t* message_length, the length of the message at the start of frame, without the CRC.
+	 * @return false if the COBS encoding or the CRC is not valid.
+	 */
+	bool 			decodeFrame(char* frame, uint32_t length, uint32_t* message_length);
+
+	//! Appends the frame of a message to a string.
+	void 			appendMessage(int type, const std::vector<int>& data, std::string& frame);
+
+	/**
+	 * Converts one or more ASCII frames into binary frames.
+	 * @return false if a type or data item is not a number or does not fit its field.
+	 */
+	bool 			convertAsciiFrames(const char* ascii, uint32_t length, std::string& frames);
+
+	/**
+	 * Takes a decoded message apart.
+	 * @return false if the length does not match a type and a whole number of data items.
+	 */
+	bool 			decodeMessage(const char* message, uint32_t length, int* type, std::vector<int>& data);
+
+	//! @return The number of data items of a decoded message, -1 if its length is not valid.
+	int 			getNrOfDataItems(uint32_t message_length);
+	//! @return The type of a decoded message.
+	int 			getType(const char* message);
+	//! @return A data item of a decoded message.
+	int 			getDataItem(const char* message, uint32_t index);
+
+	//! Sets the type of a message, before it is framed by appendFrame().
+	void 			setType(int type, char* message);
+	//! Sets a data item of a message, before it is framed by appendFrame().
+	void 			setDataItem(int value, char* message, uint32_t index);
+}
+
+#endif // BINARY_FRAME_HPP
@@ -0,0 +1,348 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	C++20 coroutine support for the HardwareController. Commands can be awaited
+* 	with co_await, the coroutine is resumed on a CommandExecutor when the
+* 	response has arrived or its deadline has passed. Only available when the
+* 	including target is compiled with coroutine support, header only for that
+* 	reason.
+*
+***********************************************************************************/
+
+#ifndef COMMAND_COROUTINE_HPP
+#define COMMAND_COROUTINE_HPP
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+/**
+ * Small pool of threads on which the coroutines waiting for a command are resumed.
+ */
+class CommandExecutor
+{
+  public:
+	CommandExecutor(unsigned int n_threads = 1)
+		: stop_(false)
+	{
+		for(unsigned int i = 0; i < n_threads; i++)
+			threads_.push_back(std::thread(&CommandExecutor::run, this));
+	}
+
+	~CommandExecutor()
+	{
+		stop();
+	}
+
+	//! Schedules a suspended coroutine for resumption, once stopped it is resumed by the calling thread instead.
+	void post(std::coroutine_handle<> handle)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if(!stop_)
+			{
+				ready_.push_back(handle);
+				condition_.notify_one();
+				return;
+			}
+		}
+
+		handle.resume();
+	}
+
+	//! Resumes the coroutines that are ready and joins the threads.
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stop_ = true;
+			condition_.notify_all();
+		}
+
+		for(auto& thread : threads_)
+			thread.join();
+		threads_.clear();
+	}
+
+	size_t get_nr_of_threads()
+	{
+		return threads_.size();
+	}
+
+  private:
+	CommandExecutor(const CommandExecutor&);
+	CommandExecutor& operator=(const CommandExecutor&);
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		while(true)
+		{
+			condition_.wait(lock, [this](){ return stop_ || !ready_.empty(); });
+			if(ready_.empty())
+				return;
+
+			std::coroutine_handle<> handle = ready_.front();
+			ready_.pop_front();
+
+			lock.unlock();
+			handle.resume();
+			lock.lock();
+		}
+	}
+
+	std::mutex 								mutex_;
+	std::condition_variable 				condition_;
+	std::deque< std::coroutine_handle<> > 	ready_;
+	bool 									stop_;
+	std::vector<std::thread> 				threads_;
+};
+
+/**
+ * Awaitable command, started when it is awaited, co_await returns its CommandResult.
+ */
+class CommandAwaitable
+{
+  public:
+	typedef std::function<void(CommandCallback)> Start;
+
+	CommandAwaitable(Start start, CommandExecutor& executor)
+		: start_(start)
+		, executor_(executor)
+		, completed_(false)
+	{}
+
+	bool await_ready()
+	{
+		return false;
+	}
+
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		// The dispatcher completes the command on response arrival or deadline, the executor resumes the coroutine.
+		// Whichever of the completion and the return of start_ comes last decides, such that the frame holding this
+		// awaitable is not resumed elsewhere while start_ still runs.
+		start_([this, handle](const CommandResult& result)
+		{
+			result_ = result;
+			if(completed_.exchange(true))
+				executor_.post(handle);
+		});
+
+		// Completed already, for example when the command was rejected, continue without suspending
+		return !completed_.exchange(true);
+	}
+
+	CommandResult await_resume()
+	{
+		return result_;
+	}
+
+  private:
+	Start 				start_;
+	CommandExecutor& 	executor_;
+	CommandResult 		result_;
+	std::atomic<bool> 	completed_;		// Set by the completion and by await_suspend(), the second one resumes
+};
+
+/**
+ * Coroutine returning a value of type T, for example a sequence of commands. It starts running when it is called,
+ * it can be awaited by another coroutine or waited for with get(). The destructor waits for it to finish.
+ */
+template<class T = bool> class CommandTask
+{
+  public:
+	struct promise_type;
+	typedef std::coroutine_handle<promise_type> Handle;
+
+	struct FinalAwaiter
+	{
+		bool await_ready() noexcept
+		{
+			return false;
+		}
+
+		std::coroutine_handle<> await_suspend(Handle handle) noexcept
+		{
+			promise_type& promise = handle.promise();
+
+			std::lock_guard<std::mutex> lock(promise.mutex);
+			promise.done = true;
+			promise.condition.notify_all();
+
+			// Continue with the coroutine awaiting this one without growing the stack
+			if(promise.continuation)
+				return promise.continuation;
+			return std::noop_coroutine();
+		}
+
+		void await_resume() noexcept
+		{}
+	};
+
+	struct promise_type
+	{
+		CommandTask get_return_object()
+		{
+			return CommandTask(Handle::from_promise(*this));
+		}
+
+		std::suspend_never initial_suspend() noexcept
+		{
+			return std::suspend_never();
+		}
+
+		FinalAwaiter final_suspend() noexcept
+		{
+			return FinalAwaiter();
+		}
+
+		void return_value(T returned_value)
+		{
+			value = returned_value;
+		}
+
+		void unhandled_exception()
+		{
+			exception = std::current_exception();
+		}
+
+		std::mutex 					mutex;
+		std::condition_variable 	condition;
+		bool 						done 		= false;
+		std::coroutine_handle<> 	continuation;
+		T 							value 		= T();
+		std::exception_ptr 			exception;
+	};
+
+	struct Awaiter
+	{
+		bool await_ready()
+		{
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> awaiting)
+		{
+			promise_type& promise = handle.promise();
+
+			// Do not suspend if it finished in the meantime
+			std::lock_guard<std::mutex> lock(promise.mutex);
+			if(promise.done)
+				return false;
+
+			promise.continuation = awaiting;
+			return true;
+		}
+
+		T await_resume()
+		{
+			if(handle.promise().exception)
+				std::rethrow_exception(handle.promise().exception);
+			return handle.promise().value;
+		}
+
+		Handle handle;
+	};
+
+	CommandTask(CommandTask&& other) noexcept
+		: handle_(other.handle_)
+	{
+		other.handle_ = nullptr;
+	}
+
+	~CommandTask()
+	{
+		if(!handle_)
+			return;
+
+		wait();
+		handle_.destroy();
+	}
+
+	Awaiter operator co_await()
+	{
+		return Awaiter{handle_};
+	}
+
+	//! Blocks until the coroutine has finished.
+	void wait()
+	{
+		promise_type& promise = handle_.promise();
+
+		std::unique_lock<std::mutex> lock(promise.mutex);
+		promise.condition.wait(lock, [&promise](){ return promise.done; });
+	}
+
+	//! Blocks until the coroutine has finished and returns its value.
+	T get()
+	{
+		wait();
+		if(handle_.promise().exception)
+			std::rethrow_exception(handle_.promise().exception);
+		return handle_.promise().value;
+	}
+
+  private:
+	explicit CommandTask(Handle handle)
+		: handle_(handle)
+	{}
+
+	CommandTask(const CommandTask&);
+	CommandTask& operator=(const CommandTask&);
+
+	Handle handle_;
+};
+
+/**
+ * Awaits a command, for example:
+ * 	CommandResult result = co_await awaitCommand(controller, command, executor);
+ * Data items that point to a variable are assigned before the coroutine is resumed.
+ */
+template<class InterfaceType>
+CommandAwaitable awaitCommand(	HardwareController<InterfaceType>& 	controller,
+								const ControllerCommand& 			command,
+								CommandExecutor& 					executor,
+								CommandPriority 					priority = COMMAND_PRIORITY_CONTROL)
+{
+	return CommandAwaitable([&controller, command, priority](CommandCallback callback)
+	{
+		controller.executeCommandAsync(command, callback, priority);
+	}, executor);
+}
+
+/**
+ * Awaits a TypedCommand, the response is decoded into the given fields before the coroutine is resumed.
+ */
+template<class Command, class InterfaceType>
+CommandAwaitable awaitTyped(HardwareController<InterfaceType>& 	controller,
+							const typename Command::Request& 	request,
+							typename Command::Response& 		response,
+							CommandExecutor& 					executor,
+							ControllerTimeout 					timeout 	= HARDWARE_CONTROL_TIMEOUT,
+							CommandPriority 					priority 	= COMMAND_PRIORITY_CONTROL)
+{
+	return CommandAwaitable([&controller, request, &response, timeout, priority](CommandCallback callback)
+	{
+		controller.template executeTypedAsync<Command>(request, response, callback, timeout, priority);
+	}, executor);
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif // COMMAND_COROUTINE_HPP
@@ -0,0 +1,324 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Dispatcher that owns the link to a low-level controller. Commands are queued
+* 	as transactions, written when the link is free and completed when their
+* 	responses have been received or their deadline has passed.
+*
+***********************************************************************************/
+
+#ifndef COMMAND_DISPATCHER_HPP
+#define COMMAND_DISPATCHER_HPP
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rose_hardware_comm/hardware_comm.hpp"
+#include "rose_hardware_controller/controller_response.hpp"
+#include "rose_hardware_controller/frame_parser.hpp"
+#include "rose_hardware_controller/latency_histogram.hpp"
+
+#define COMMAND_DISPATCHER_SAFETY_QUEUE_LIMIT		4
+#define COMMAND_DISPATCHER_CONTROL_QUEUE_LIMIT		64
+#define COMMAND_DISPATCHER_BULK_QUEUE_LIMIT			16
+#define COMMAND_DISPATCHER_SAFETY_RETRY_LIMIT		2
+#define COMMAND_DISPATCHER_CONTROL_RETRY_LIMIT		2
+#define COMMAND_DISPATCHER_BULK_RETRY_LIMIT			1
+#define COMMAND_DISPATCHER_UNKNOWN_COMMAND			102		// Response type with which the controller answers commands it does not know
+#define COMMAND_DISPATCHER_MAX_LATE_RESPONSES		8		// Types of timed out transactions of which the response may still arrive
+
+/**
+ * Priority classes, a queued transaction of a higher class is always written before those of lower classes.
+ * A transaction in flight is never interrupted, so a safety transaction waits for at most one exchange.
+ */
+enum CommandPriority
+{
+	COMMAND_PRIORITY_SAFETY, 				// Watchdog
+	COMMAND_PRIORITY_CONTROL, 				// Setpoints and other user commands
+	COMMAND_PRIORITY_BULK, 					// Diagnostics and large transfers
+	COMMAND_PRIORITY_COUNT,
+};
+
+/**
+ * Statistics of a priority class, latencies are from submission until completion.
+ */
+struct CommandClassStats
+{
+	CommandClassStats();
+
+	uint64_t 					n_completed;
+	uint64_t 					n_failed;
+	uint64_t 					n_rejected;		// Submitted while the queue of the class was full
+	uint64_t 					n_retries;		// Transactions written again after a damaged response
+	uint32_t 					max_queued;		// Largest number of queued transactions seen
+	std::chrono::microseconds 	total_latency;
+	std::chrono::microseconds 	max_latency;
+	std::chrono::microseconds 	max_queue_wait;	// From submission until written
+};
+
+/**
+ * Outcome of a transaction.
+ */
+struct CommandResult
+{
+	CommandResult();
+
+	bool 						success;		// All expected responses have been received and passed their check
+	bool 						timed_out;		// At least one expected response was not received in time
+	ControllerResponse 			response;		// The last received response
+	std::vector<int> 			values;			// The data items of the last received response, 0 if not a number
+	std::chrono::microseconds 	latency;		// From submitting the transaction until its completion
+	uint32_t 					n_retries;		// Number of times the transaction has been written again
+};
+
+typedef std::function<void(const CommandResult&)> 		CommandCallback;
+typedef std::function<bool(ControllerResponse&)> 		ResponseChecker;
+typedef std::function<void(ControllerResponse&)> 		TelemetryHandler;
+typedef std::function<void(std::chrono::steady_clock::time_point)> 	DeadlineNotifier;
+
+/**
+ * A message to write to the controller and the responses it is answered with.
+ */
+struct CommandTransaction
+{
+	CommandTransaction(const std::string& message);
+	CommandTransaction(const char* message, uint32_t length);
+
+	/**
+	 * Adds an expected response, responses are expected in the order in which they are added.
+	 * @param[in] const ControllerResponse& expected, the type and the timeout of the response.
+	 * @param[in] ResponseChecker checker, checks the received response, may be empty.
+	 */
+	void 								expectResponse(const ControllerResponse& expected, ResponseChecker checker);
+
+	std::string 						message;
+	std::string 						binary_message;		// The message in the binary frame format, if empty it is converted from message when written
+	std::vector<ControllerResponse> 	expected;
+	std::vector<ResponseChecker> 		checkers;
+	unsigned int 						pipeline_depth;		// Written while up to pipeline_depth - 1 other pipelined transactions are in flight
+	bool 								match_by_type;		// Responses go to the oldest transaction in flight expecting their type
+	CommandPriority 					priority;
+	bool 								retryable;			// Executing it twice does no harm, it may be written again after a damaged response
+	CommandCallback 					callback;			// Called once on completion, from the thread that completed it
+	bool 								switches_frame_format;	// The link uses frame_format after this transaction passed
+	FrameFormat 						frame_format;
+
+	// Managed by the dispatcher
+	uint32_t 								n_received;
+	uint32_t 								n_retries;
+	std::chrono::steady_clock::time_point 	queued_time;
+	std::chrono::steady_clock::time_point 	write_time;
+	std::chrono::steady_clock::time_point 	first_byte_time;
+	std::chrono::steady_clock::time_point 	deadline;		// Of the next expected response
+	bool 									has_kept_response;	// result.response holds a discarded owed response, it answers if no other does before the deadline
+	CommandResult 							result;
+};
+
+typedef boost::shared_ptr<CommandTransaction> CommandTransactionPtr;
+
+/**
+ * CommandDispatcher class, all writes to the communication interface go through it. Transactions are written
+ * by priority class and in submission order within a class, one at a time unless they are pipelined. The owner feeds it the received responses and
+ * lets it expire the transactions of which the deadline has passed. Callbacks are called without holding the
+ * lock of the dispatcher, they are allowed to submit new transactions but not to wait for them. Writes are done
+ * without holding the lock as well, by one thread at a time, such that a write that waits for the port does not
+ * stall the submitters or the handling of responses by other threads.
+ */
+class CommandDispatcher
+{
+  public:
+	CommandDispatcher();
+	~CommandDispatcher();
+
+	void 		set_comm_interface(HardwareComm* comm_interface);
+
+	//! Accept transactions.
+	void 		start();
+	//! Fails all queued and in flight transactions and rejects new ones.
+	void 		stop();
+
+	/**
+	 * Defers the writes to the thread owning the link: submit() only queues the transaction and calls the notifier,
+	 * the owner then calls flush(). Without a notifier submit() writes from the calling thread.
+	 */
+	void 		set_write_notifier(std::function<void()> notifier);
+
+	//! Writes the queued transactions for which the link is free.
+	void 		flush();
+
+	/**
+	 * Called with the earliest deadline of the transactions written by a write, after the write and without holding
+	 * the lock of the dispatcher, such that a thread waiting for the deadlines can wait for an earlier one.
+	 */
+	void 		set_deadline_notifier(DeadlineNotifier notifier);
+
+	/**
+	 * The format in which the messages are written and the responses are received. Messages are queued in the ASCII
+	 * format, in the binary format a transaction is written as binary message as encoded by its submitter, or else is
+	 * converted when written. A transaction that switches the format is written when no other transaction is in flight
+	 * and the format is switched when its response passed, before anything else is written.
+	 */
+	void 		set_frame_format(FrameFormat frame_format);
+	//! @return The frame format, without locking the dispatcher such that the reader can check it every frame.
+	FrameFormat get_frame_format();
+
+	/**
+	 * Limits the number of queued transactions of a priority class.
+	 */
+	void 		set_queue_limit(CommandPriority priority, uint32_t limit);
+	uint32_t 	get_queue_limit(CommandPriority priority);
+
+	/**
+	 * Limits the number of times a transaction of a priority class is written again when its response is damaged.
+	 * Only a retryable transaction alone in flight is written again, pipelined transactions wait for their deadline.
+	 */
+	void 		set_retry_limit(CommandPriority priority, uint32_t limit);
+
+	/**
+	 * Routes the received responses of a type to a handler instead of to the transactions in flight, for frames the
+	 * controller sends by itself, like streamed telemetry. The handler is called from the thread reading the responses
+	 * without holding the lock of the dispatcher, like a callback.
+	 * @param[in] int type, the response type.
+	 * @param[in] TelemetryHandler handler, replaces the handler of the type, an empty handler removes it.
+	 */
+	void 		set_telemetry_handler(int type, TelemetryHandler handler);
+
+	//! @return The number of responses handled by telemetry handlers.
+	uint64_t 	getNrOfTelemetryResponses();
+
+	/**
+	 * Queues a transaction, it is written as soon as the link is free and no transaction of a higher class is queued.
+	 * @return false if the dispatcher is stopped or the queue of its class is full, the transaction has then been
+	 * completed unsuccessfully.
+	 */
+	bool 		submit(const CommandTransactionPtr& transaction);
+
+	/**
+	 * Hands a received response to the telemetry handler of its type, or else to the transaction in flight it belongs to.
+	 * A response of another type than the oldest transaction expects is the late response of a timed out transaction,
+	 * which is discarded, or else is taken as damaged. Responses still owed to transactions that were written again or
+	 * failed after a damaged frame are discarded first, also if the oldest transaction expects their type. That
+	 * transaction keeps it, it answers the transaction if no other response follows within twice the round trip of the
+	 * write it answered. With telemetry handlers registered a response of an unexpected type is only discarded.
+	 * @return false if it does not belong to any handler or transaction.
+	 */
+	bool 		handleResponse(ControllerResponse& response);
+
+	/**
+	 * Reports a frame that has been dropped because it was damaged, the transaction in flight is written again at once
+	 * instead of waiting for its deadline, or fails at once if it has no retries left or is not retryable. With telemetry
+	 * handlers registered the damaged frame may have been telemetry, the response to the first write is then still owed
+	 * and discarded when it arrives, a transaction that is not retryable waits for it instead. A transaction that kept a
+	 * discarded response is answered by it instead.
+	 */
+	void 		handleFrameError();
+
+	/**
+	 * Reports a damaged frame of which the type could still be read. Damaged telemetry and late responses leave the
+	 * transaction in flight waiting for its response, else it is handled like handleFrameError().
+	 */
+	void 		handleFrameError(ControllerResponse& damaged);
+
+	//! @return The number of damaged frames and responses received.
+	uint64_t 	getNrOfFrameErrors();
+	//! @return The number of late responses that have been discarded.
+	uint64_t 	getNrOfDiscardedResponses();
+
+	//! @return When a response last passed its check, time_point() if none did yet. Telemetry does not count.
+	std::chrono::steady_clock::time_point 	getLastExchangeTime();
+
+	//! Expires the expected responses of which the deadline has passed.
+	void 		handleTimeouts(std::chrono::steady_clock::time_point now);
+
+	//! @return The earliest deadline of the transactions in flight, time_point::max() if there are none.
+	std::chrono::steady_clock::time_point 	nextDeadline();
+
+	//! @return true if there are no queued or in flight transactions.
+	bool 		isIdle();
+
+	//! @return The statistics of a priority class.
+	CommandClassStats 	getStats(CommandPriority priority);
+	//! Resets the statistics of all priority classes.
+	void 				resetStats();
+
+	/**
+	 * Marks the arrival of received bytes, the first bytes after the write of a transaction in flight give its time to
+	 * the first byte. Call before handing the responses in the bytes to handleResponse().
+	 */
+	void 		handleBytesReceived(std::chrono::steady_clock::time_point now);
+
+	//! @return The latency statistics per command type, taken without locking the dispatcher.
+	std::vector<CommandLatencyStats> 	getLatencyStats();
+	//! Resets the latency statistics of all command types.
+	void 								resetLatencyStats();
+
+  private:
+	CommandDispatcher(const CommandDispatcher&);
+	CommandDispatcher& operator=(const CommandDispatcher&);
+
+	bool 		mayWrite(const CommandTransactionPtr& transaction);
+	std::deque<CommandTransactionPtr>* 	nextQueue();
+	void 		pump();
+	void 		write();
+	void 		frameError(bool response_may_follow, std::vector<CommandTransactionPtr>& completed);
+	void 		owe(const CommandTransactionPtr& transaction);
+	void 		answer(const CommandTransactionPtr& transaction, ControllerResponse& response, std::vector<CommandTransactionPtr>& completed);
+	void 		received(const CommandTransactionPtr& transaction, bool success, std::vector<CommandTransactionPtr>& completed);
+	void 		finish(const CommandTransactionPtr& transaction, bool success, std::vector<CommandTransactionPtr>& completed);
+	void 		notify(std::vector<CommandTransactionPtr>& completed);
+	int 		commandId(const CommandTransactionPtr& transaction, uint32_t response_index);
+
+	HardwareComm* 							comm_interface_;
+	std::function<void()> 					write_notifier_;
+	DeadlineNotifier 						deadline_notifier_;
+	std::mutex 								mutex_;
+	bool 									running_;
+	std::deque<CommandTransactionPtr> 		unwritten_;			// Taken off the queues by pump(), written by write() without holding the lock
+	bool 									writing_;			// A thread is in write(), the others leave the writes to it
+	std::deque<CommandTransactionPtr> 		queued_[COMMAND_PRIORITY_COUNT];
+	uint32_t 								queue_limits_[COMMAND_PRIORITY_COUNT];
+	uint32_t 								retry_limits_[COMMAND_PRIORITY_COUNT];
+	CommandClassStats 						stats_[COMMAND_PRIORITY_COUNT];
+	std::deque<CommandTransactionPtr> 		in_flight_;
+	std::atomic<FrameFormat> 				frame_format_;
+	std::string 							binary_message_;	// Reused for the conversion of the messages written without binary message
+
+	std::map<int, boost::shared_ptr<TelemetryHandler> > 	telemetry_handlers_;
+	uint64_t 								n_telemetry_responses_;
+
+	/**
+	 * A response still owed to a transaction that was written again, answered or failed after a frame error, or
+	 * answered by a kept response.
+	 */
+	struct OwedResponse
+	{
+		int 									type;
+		std::chrono::steady_clock::time_point 	write_time;		// Of the write it answers
+		std::chrono::steady_clock::time_point 	deadline;		// After which it is not expected anymore
+	};
+
+	std::deque<int> 						late_types_;		// Expected types of the recently timed out transactions
+	std::deque<OwedResponse> 				owed_responses_;
+	uint64_t 								n_frame_errors_;
+	uint64_t 								n_discarded_responses_;
+	std::chrono::steady_clock::time_point 	last_exchange_time_;
+
+	CommandLatencyTable 					latency_stats_;
+};
+
+#endif // COMMAND_DISPATCHER_HPP
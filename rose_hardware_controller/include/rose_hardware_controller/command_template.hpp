@@ -0,0 +1,114 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	A command that is encoded once and sent many times. Its data items can be
+* 	patched in place before each send and the check of its response is prepared
+* 	together with it.
+*
+***********************************************************************************/
+
+#ifndef COMMAND_TEMPLATE_HPP
+#define COMMAND_TEMPLATE_HPP
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "rose_hardware_controller/controller_command.hpp"
+
+/**
+ * CommandTemplate class, holds the encoded frame of a ControllerCommand in a buffer sized for its widest
+ * data items, such that patching a data item never allocates. The binary message is kept next to it. The expected response is reduced to its type,
+ * its timeout and per data item the variable to assign and the value to check, integer values are compared
+ * without going through their string.
+ *
+ * Patch the data items and the expected values only while no command of the template is in flight, the
+ * response of a command is checked against the template.
+ */
+class CommandTemplate
+{
+  public:
+	CommandTemplate(ControllerCommand command);
+
+	//! @return The encoded frame, not zero terminated.
+	const char* 			getMessage();
+	uint32_t 				getMessageLength();
+
+	/**
+	 * @return The frame in the binary frame format, empty if the command or a data item is not a number. It is kept
+	 * next to the ASCII frame and only framed again after a data item has been patched.
+	 */
+	const std::string& 		getBinaryMessage();
+
+	//! @return The command string.
+	const std::string& 		getCommand();
+
+	//! @return true if the command may be written again when its response is damaged, as set on the ControllerCommand.
+	bool 					isRetryable();
+
+	//! @return The number of data items of the command.
+	uint32_t 				getNrOfDataItems();
+
+	/**
+	 * Replaces a data item of the command.
+	 * @return false if the index is out of range.
+	 */
+	bool 					set_data_item(uint32_t index, int value);
+
+	/**
+	 * Replaces the value expected for a data item of the response, for example when it echoes a patched data item.
+	 * @return false if the index is out of range.
+	 */
+	bool 					set_expected_data_item(uint32_t index, int value);
+
+	//! @return The type and the timeout of the expected response, without data items.
+	const ControllerResponse& 	getExpectedResponse();
+
+	/**
+	 * Checks a response like HardwareController::checkResponse() and assigns the coupled variables.
+	 * @return false if the type, the number of data items or an expected value does not match.
+	 */
+	bool 					checkResponse(ControllerResponse& response);
+
+  private:
+	/**
+	 * A data item in the encoded frame.
+	 */
+	struct Field
+	{
+		uint32_t 	offset;
+		uint32_t 	length;
+	};
+
+	/**
+	 * A data item of the expected response.
+	 */
+	struct ExpectedItem
+	{
+		int* 		pointer;			// Assigned from the received data item, NULL for none
+		bool 		is_checked;
+		bool 		is_integer;			// Compared as number, else as string
+		int 		value;
+		std::string data;
+	};
+
+	std::string 				command_;
+	std::vector<char> 			message_;
+	uint32_t 					message_length_;
+	std::vector<Field> 			fields_;
+	bool 						retryable_;
+	std::vector<char> 			binary_message_;	// Type and data items before framing, empty if not all are numbers
+	std::string 				binary_frame_;
+	bool 						binary_frame_stale_;	// A data item has been patched since binary_frame_ was framed
+
+	ControllerResponse 			expected_response_;
+	std::vector<ExpectedItem> 	expected_items_;
+};
+
+#endif // COMMAND_TEMPLATE_HPP
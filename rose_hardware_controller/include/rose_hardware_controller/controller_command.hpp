@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include <list>
+#include <vector>
 
 #include "rose_hardware_controller/controller_data.hpp"
 #include "rose_hardware_controller/controller_response.hpp"
@@ -53,6 +54,18 @@ class ControllerCommand
 		 */	
 		std::string 			getSerialMessage();
 
+		/**
+		 * Encodes the type and the data items of the binary frame format, without the framing.
+		 * @return false if the command or a data item is not a number or does not fit its field.
+		 */
+		bool 					getBinaryMessage(std::vector<char>& message);
+
+		/**
+		 * Appends the frame of the message in the binary frame format to a string, encoded from the data items.
+		 * @return false if the command or a data item is not a number or does not fit its field.
+		 */
+		bool 					appendBinaryMessage(std::string& frame);
+
 		/**
 		* Adds a ControllerData instance to the list of data items.
 		* @return true, if the dataitem has succesfully been added
@@ -95,6 +108,17 @@ class ControllerCommand
 		 */
 		void 					setExpectedResponse(ControllerResponse expected_response);
 
+		/**
+		 * Marks the command as safe to execute twice, like a status request or setting an absolute value. Only such a
+		 * command is written again when its response is damaged, a relative move or a counter update is not.
+		 */
+		void 					setRetryable(bool retryable);
+
+		/**
+		 * @return true if the command may be written again when its response is damaged.
+		 */
+		bool 					isRetryable();
+
 		/**
 		 * @return The command string.
 		 */
@@ -103,7 +127,7 @@ class ControllerCommand
 		/**
 		 * @return The expected response.
 		 */
-		ControllerResponse 		getExpectedResponse();
+		ControllerResponse& 	getExpectedResponse();
 
 		/**
 		 * Gets the list of data items.
@@ -116,6 +140,7 @@ class ControllerCommand
 		std::string 				command_;
 		ControllerResponse 			expected_response_;
 		std::list<ControllerData>	data_;
+		bool 						retryable_;
 };
 
 #endif // LIFT_CONTROLLER_COMMAND_HPP
@@ -20,6 +20,7 @@
 
 #include "rose_common/common.hpp"
 #include "rose_conversions/conversions.hpp"
+#include "rose_hardware_controller/number_codec.hpp"
  
 /**
  * The ControllerData represents one data item, a number of overridden constructors setting the datafields accordingly.
@@ -111,7 +112,7 @@ class ControllerData
     /**
     * @return The stringalized data item
     */
-  	std::string 	 getData();
+  	const std::string& getData();
 
     /**
     * @return Pointer to the coupled variable
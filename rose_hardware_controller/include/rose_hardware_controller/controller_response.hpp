@@ -18,23 +18,58 @@
 #include <stdio.h>
 
 #include <list>
+#include <vector>
+#include <chrono>
 
 #include "rose_hardware_controller/controller_data.hpp"
 
-#define DEFAULT_TIMEOUT			5
+#define DEFAULT_TIMEOUT			5		// [s]
 
+/**
+ * Time to wait for a controller response. Implicitly constructible from an integer number 
+ * of seconds and from any std::chrono duration, such that sub-millisecond timeouts can be given.
+ */
+class ControllerTimeout
+{
+  public:
+	ControllerTimeout(int seconds);
+
+	template<class Rep, class Period>
+	ControllerTimeout(const std::chrono::duration<Rep, Period>& duration)
+		: duration_(std::chrono::duration_cast<std::chrono::microseconds>(duration))
+	{}
+
+	std::chrono::microseconds 	get_duration() const;
+
+  private:
+	std::chrono::microseconds 	duration_;
+};
+
+/**
+ * ControllerResponse class, the response string is tokenized once when it is set, after that the type 
+ * and the received data items are available in O(1) without allocating.
+ */
 class ControllerResponse
 {
   public:
   	ControllerResponse();
 	ControllerResponse(const std::string& response);
-	ControllerResponse(const std::string& response, int timeout);
+	ControllerResponse(const std::string& response, ControllerTimeout timeout);
 	~ControllerResponse();
 
 	void 						addCharacter(char character);
-	std::string					get_response();
+	const std::string&			get_response();
 	bool  						set_response(const std::string& response);
+	bool  						set_response(const char* response, uint32_t length);
+
+	/**
+	 * Sets the response from a decoded binary message, the data items are available as if it had been received in
+	 * the ASCII format.
+	 * @return false if the length of the message is not valid.
+	 */
+	bool 						set_binary_response(const char* message, uint32_t length);
 	int 						get_timeout();
+	std::chrono::microseconds 	get_timeout_duration();
 	std::string					get_type();
 	std::string					getRawData();
 	std::string					getPrettyReceivedData();
@@ -42,13 +77,66 @@ class ControllerResponse
 	std::string					getPrettyString();
 	bool 						hasData();
 	bool 						addExpectedDataItem(ControllerData data_item);
-	std::list<ControllerData> 	getExpectedDataItems();
+	std::list<ControllerData>& 	getExpectedDataItems();
 	std::list<ControllerData> 	getReceivedDataItems();
+
+	/**
+	 * @return true if the type of this response equals the type of the other response.
+	 */
+	bool 						hasSameType(ControllerResponse& other);
+
+	/**
+	 * Gets the type as integer, command types are numbers.
+	 * @return false if the type is not an integer.
+	 */
+	bool 						getTypeInt(int* type);
+
+	/**
+	 * @return The number of received data items.
+	 */
+	uint32_t 					getNrOfReceivedDataItems();
+
+	/**
+	 * Gets a received data item without copying it.
+	 * @param[in] uint32_t index, index of the data item.
+	 * @param[out] uint32_t* length, the length of the data item.
+	 * @return Pointer to the start of the data item in the response, not zero terminated.
+	 */
+	const char* 				getReceivedDataItem(uint32_t index, uint32_t* length);
+
+	/**
+	 * Gets the integer value of a received data item, parsed while tokenizing.
+	 * @return false if the data item is not an integer.
+	 */
+	bool 						getReceivedDataItemInt(uint32_t index, int* value);
+
+	/**
+	 * @return true if the received data item equals the given string.
+	 */
+	bool 						receivedDataItemEquals(uint32_t index, const std::string& value);
   
   private:
+	/**
+	 * A data item in the response string.
+	 */
+	struct Field
+	{
+		uint32_t 	offset;
+		uint32_t 	length;
+		int 		value;
+		bool 		is_integer;
+	};
+
+	void 						tokenize();
+
 	std::string 				response_;
-	int 						timeout_;
+	std::chrono::microseconds 	timeout_;
 	std::list<ControllerData> 	expected_data_;
+
+	bool 						tokenized_;
+	uint32_t 					type_length_;
+	bool 						has_separator_;		// The response contains at least one comma
+	std::vector<Field> 			fields_;
 };
 
 #endif // LIFT_CONTROLLER_RESPONSE_HPP
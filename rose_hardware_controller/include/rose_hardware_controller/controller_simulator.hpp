@@ -0,0 +1,156 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Simulated low-level controller on a pseudo terminal. A Serial interface can
+* 	connect to its port like to a real controller, it answers the built-in
+* 	commands and a set of registers with a configurable delay, jitter and loss.
+*
+***********************************************************************************/
+
+#ifndef CONTROLLER_SIMULATOR_HPP
+#define CONTROLLER_SIMULATOR_HPP
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ros/ros.h>
+
+#include "rose_hardware_controller/frame_parser.hpp"
+#include "ros_name/ros_name.hpp"
+
+#define ROS_NAME_SIMULATOR 						(ROS_NAME + "|SIMULATOR")
+
+#define CONTROLLER_SIMULATOR_UNKNOWN_COMMAND 	102		// Answer to commands that are not known
+#define CONTROLLER_SIMULATOR_READ_SIZE 			4096	// [bytes]
+
+/**
+ * Behaviour of a simulated controller.
+ */
+struct SimulatorConfig
+{
+	SimulatorConfig();
+
+	int 						controller_id;
+	int 						firmware_major_version;
+	int 						firmware_minor_version;
+	int 						nr_of_timers;
+	std::chrono::microseconds 	response_delay;			// From receiving a command until answering it
+	std::chrono::microseconds 	response_jitter;		// Uniformly distributed extra delay, up to this
+	double 						byte_loss;				// Probability that a byte of a response is dropped
+	int 						baudrate;				// Emulated line rate [bits/s] at 10 bits per byte, 0 for none
+	bool 						binary_frames;			// Accepts to switch to the binary frame format
+	bool 						implicit_heartbeat;		// Accepts to take every command as heartbeat of the watchdog
+	uint32_t 					seed;					// Of the jitter and the loss, such that runs are reproducible
+	int 						telemetry_type;			// Response type streamed unsolicited, 0 for none
+	std::chrono::microseconds 	telemetry_period;
+};
+
+/**
+ * Answers a command, gets the data items of the command and fills the data items of the response.
+ * @return false if the command is not known, it is then answered as unknown.
+ */
+typedef std::function<bool(int command, const std::vector<int>& request, std::vector<int>& response)> SimulatorHandler;
+
+/**
+ * ControllerSimulator class, owns the master side of a pseudo terminal and serves it from its own thread.
+ * Commands are answered in order, a response is written when its delay has passed, later commands are read
+ * in the meantime such that pipelined commands are answered back-to-back. A pseudo terminal transfers at
+ * memory speed, with an emulated baud rate a response is held back for the time the command and the
+ * response would take on the line.
+ *
+ * A register is read with '$<register>,\r' and written with '$<register>,<value>,\r', both are answered with
+ * its value. The built-in commands are 100 to 101 and 111 to 117. Setting the watchdog treshold starts the watchdog,
+ * it expires when no heartbeat arrives within the treshold.
+ */
+class ControllerSimulator
+{
+  public:
+	ControllerSimulator(const SimulatorConfig& config = SimulatorConfig());
+	~ControllerSimulator();
+
+	//! Opens the pseudo terminal and starts answering.
+	bool 				start();
+	//! Stops answering and closes the pseudo terminal, a connected Serial sees a hang up.
+	void 				stop();
+
+	//! @return The device name of the slave side, to connect a Serial interface to.
+	const std::string& 	get_port_name();
+
+	void 				set_register(int command, int value);
+	bool 				get_register(int command, int* value);
+
+	//! Answers a command instead of the built-in commands and the registers, an empty handler removes it.
+	void 				set_handler(int command, SimulatorHandler handler);
+
+	//! Changes the probability that a byte of a response is dropped, for example after the link has been set up.
+	void 				set_byte_loss(double byte_loss);
+
+	//! @return The number of commands received.
+	uint64_t 			getNrOfCommands();
+	//! @return The number of response bytes dropped to simulate loss.
+	uint64_t 			getNrOfDroppedBytes();
+	//! @return The number of watchdog commands received, as reported in the watchdog response.
+	int 				getWatchdogCount();
+	//! @return The number of times the watchdog expired, a real controller would have stopped then.
+	uint64_t 			getNrOfWatchdogExpirations();
+
+  private:
+	ControllerSimulator(const ControllerSimulator&);
+	ControllerSimulator& operator=(const ControllerSimulator&);
+
+	void 				serve();
+	void 				handleFrame(const char* frame, uint32_t length, std::chrono::steady_clock::time_point now);
+	bool 				decodeFrame(const char* frame, uint32_t length, int* command, std::vector<int>& request);
+	bool 				answer(int command, const std::vector<int>& request, std::vector<int>& response);
+	std::string 		encodeResponse(int type, const std::vector<int>& data);
+	std::chrono::microseconds 	transmissionTime(uint32_t n_bytes);
+	void 				writeDue(std::chrono::steady_clock::time_point now);
+	void 				checkWatchdog(std::chrono::steady_clock::time_point now);
+	std::chrono::steady_clock::time_point 	watchdogDeadline();
+
+	SimulatorConfig 						config_;
+	int 									master_fd_;
+	int 									slave_fd_;			// Kept open such that the port does not hang up between connects
+	int 									stop_fd_;
+	std::string 							port_name_;
+	std::thread 							thread_;
+	std::atomic<bool> 						running_;
+	std::atomic<double> 					byte_loss_;
+
+	FrameParser 							frame_parser_;
+	FrameFormat 							frame_format_;
+	std::mt19937 							random_;
+	std::multimap<std::chrono::steady_clock::time_point, std::string> 	pending_;		// Responses by due time
+	std::chrono::steady_clock::time_point 	last_due_;			// Keeps the responses in order when jitter is applied
+	std::chrono::steady_clock::time_point 	next_telemetry_;
+	int 									telemetry_count_;
+
+	std::mutex 								mutex_;				// Guards the registers and the handlers
+	std::map<int, int> 						registers_;
+	std::map<int, SimulatorHandler> 		handlers_;
+	int 									watchdog_treshold_;	// [ms] 0 while the watchdog is not started
+	bool 									implicit_heartbeat_;
+	bool 									watchdog_expired_;
+	std::chrono::steady_clock::time_point 	last_heartbeat_;
+
+	std::atomic<uint64_t> 					n_commands_;
+	std::atomic<uint64_t> 					n_dropped_bytes_;
+	std::atomic<int> 						watchdog_count_;
+	std::atomic<uint64_t> 					n_watchdog_expirations_;
+};
+
+#endif // CONTROLLER_SIMULATOR_HPP
@@ -0,0 +1,104 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Streaming parser for the '$...\r' framed controller protocol. Scans blocks of
+* 	received bytes for frame delimiters and collects frames in a reusable buffer.
+* 	Also parses the zero delimited frames of the binary format.
+* 
+***********************************************************************************/
+
+#ifndef FRAME_PARSER_HPP
+#define FRAME_PARSER_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+#define FRAME_PARSER_START					'$'
+#define FRAME_PARSER_MAX_FRAME_LENGTH		65536	// [bytes]
+
+/**
+ * Format of the frames on the link.
+ */
+enum FrameFormat
+{
+	FRAME_FORMAT_ASCII, 			// '$type,item,...,\r'
+	FRAME_FORMAT_BINARY, 			// COBS encoded binary message and CRC, see binary_frame.hpp
+};
+
+/**
+ * FrameParser class, a '$' starts a new frame and a '\r' or '\n' terminates it.
+ * Empty frames are skipped, frames longer than the maximum frame length are dropped.
+ * In the binary format a zero byte terminates a frame, it is decoded in place and dropped if its CRC is not valid.
+ */
+class FrameParser
+{
+  public:
+	/**
+	 * Constructor of the FrameParser class.
+	 * @param[in] uint32_t max_frame_length, the size of the frame buffer.
+	 */
+	FrameParser(uint32_t max_frame_length = FRAME_PARSER_MAX_FRAME_LENGTH);
+	~FrameParser();
+
+	/**
+	 * Consumes bytes up to and including the first frame delimiter.
+	 * @param[in] const char* data, the received bytes.
+	 * @param[in] uint32_t length, the number of received bytes.
+	 * @param[out] bool* frame_complete, true if a frame has been terminated, it is available through getFrame() until the next call.
+	 * @return The number of bytes consumed, call again with the remainder until all bytes are consumed.
+	 */
+	uint32_t 		parse(const char* data, uint32_t length, bool* frame_complete);
+
+	//! @return The last completed frame, without the delimiters, not zero terminated.
+	const char* 	getFrame();
+	//! @return The length of the last completed frame.
+	uint32_t 		getFrameLength();
+
+	/**
+	 * @return The length of the frame the last call dropped because a '$' arrived before its terminator, 0 if it dropped
+	 * none. Its bytes are available through getFrame() until the next call.
+	 */
+	uint32_t 		getTruncatedFrameLength();
+	//! Discards the frame that is being received.
+	void 			reset();
+	//! @return true if part of a frame has been received, without its terminator.
+	bool 			isInFrame();
+
+	//! Parses the frames after this in the given format, discards the frame that is being received if it changes.
+	void 			set_frame_format(FrameFormat frame_format);
+	FrameFormat 	get_frame_format();
+
+	//! @return The number of frames dropped because they exceeded the maximum frame length.
+	uint64_t 		get_overflow_count();
+	//! @return The number of binary frames dropped because they could not be decoded.
+	uint64_t 		get_corrupt_count();
+	//! @return The number of ASCII frames dropped because a '$' arrived before their terminator.
+	uint64_t 		get_truncated_count();
+	//! @return The number of frames dropped for any reason, a change means that received bytes have been lost.
+	uint64_t 		get_dropped_count();
+
+  private:
+	FrameParser(const FrameParser&);
+	FrameParser& operator=(const FrameParser&);
+
+	void 			append(const char* data, uint32_t length);
+	uint32_t 		parseBinary(const char* data, uint32_t length, bool* frame_complete);
+
+	char* 		buffer_;
+	FrameFormat frame_format_;
+	uint32_t 	capacity_;
+	uint32_t 	length_;
+	bool 		frame_done_;		// The buffer holds a completed frame, start over on the next byte
+	bool 		overflow_;			// The current frame did not fit
+	uint32_t 	truncated_length_;
+	uint64_t 	overflow_count_;
+	uint64_t 	corrupt_count_;
+	uint64_t 	truncated_count_;
+};
+
+#endif // FRAME_PARSER_HPP
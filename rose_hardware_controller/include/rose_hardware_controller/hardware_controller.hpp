@@ -19,15 +19,24 @@
 #include <iostream>
 #include <stdio.h>
 
-#include <ros/ros.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <vector>
 
-#include "thread_safe_stl_containers/thread_safe_queue.h"
+#include <ros/ros.h>
 
+#include "rose_hardware_controller/command_dispatcher.hpp"
 #include "rose_hardware_controller/controller_data.hpp"
 #include "rose_hardware_controller/controller_command.hpp"
+#include "rose_hardware_controller/command_template.hpp"
 #include "rose_hardware_controller/controller_response.hpp"
+#include "rose_hardware_controller/frame_parser.hpp"
+#include "rose_hardware_controller/typed_command.hpp"
 #include "rose_hardware_controller/hardware_timer.hpp"
 #include "rose_hardware_comm/hardware_comm.hpp"
+#include "rose_hardware_comm/io_reactor.hpp"
 #include "rose_hardware_comm/serial.hpp"
 
 #define ROS_NAME_HC                         (ROS_NAME + "|HC")
@@ -41,24 +50,50 @@
 #define HARDWARE_CONTROL_GET_WATCHDOG_TRESHOLD      "113"
 #define HARDWARE_CONTROL_GET_NR_OF_TIMERS           "114"
 #define HARDWARE_CONTROL_GET_TIMERS                 "115"
+#define HARDWARE_CONTROL_SET_FRAME_FORMAT           "116"
+#define HARDWARE_CONTROL_SET_IMPLICIT_HEARTBEAT     "117"
+
+// Typed built-in commands
+typedef TypedCommand<100, std::tuple<>,    std::tuple<int> >                                    ControllerIdCommand;
+typedef TypedCommand<101, std::tuple<>,    std::tuple<int, int> >                               FirmwareVersionCommand;
+typedef TypedCommand<111, std::tuple<int>, std::tuple<int, int, IgnoredField, IgnoredField> >   WatchdogCommand;
+typedef TypedCommand<112, std::tuple<int>, std::tuple< EchoField<0> > >                         SetWatchdogTresholdCommand;
+typedef TypedCommand<113, std::tuple<>,    std::tuple<int> >                                    GetWatchdogTresholdCommand;
+typedef TypedCommand<114, std::tuple<>,    std::tuple<int> >                                    GetNrOfTimersCommand;
+typedef TypedCommand<115, std::tuple<>,    std::tuple<RepeatedField> >                          GetTimersCommand;
+typedef TypedCommand<116, std::tuple<int>, std::tuple< EchoField<0> > >                         SetFrameFormatCommand;
+typedef TypedCommand<117, std::tuple<int>, std::tuple< EchoField<0> > >                         SetImplicitHeartbeatCommand;
 
 // Timeouts
 #define HARDWARE_CONTROL_TIMEOUT                    1       // [s]
 #define HARDWARE_CONTROL_RESET_COMM_TIMEOUT         2       // [s]
+#define HARDWARE_CONTROL_REACTOR_READ_SIZE          4096    // [bytes]
+#define HARDWARE_CONTROL_FRAME_GAP                  50      // [ms] Silence within a frame after which it is taken as damaged
 
 #define HARDWARE_CONTROL_DEBUG                      true    // Turn debug messages of hardware controller on and off
 
 // Default parameters
 #define HARDWARE_CONTROL_DEFAULT_WATCHDOG_TIMEOUT   1000    // [ms]
 #define HARDWARE_CONTROL_WATCHDOG_RATE              10      // [hz]
+#define HARDWARE_CONTROL_DEFAULT_HEARTBEAT_IDLE_TIME 300    // [ms] Idle time of the link after which the watchdog is sent with an implicit heartbeat
+#define HARDWARE_CONTROL_DEFAULT_PIPELINE_DEPTH     4       // Commands in flight in executePipelined()
 
 using namespace std;
 
+/**
+ * How executePipelined() matches received responses to the commands in flight.
+ */
+enum PipelineMatching
+{
+    PIPELINE_MATCH_IN_ORDER,        // Responses arrive in the order the commands were written
+    PIPELINE_MATCH_BY_TYPE,         // A response belongs to the oldest command in flight expecting its type
+};
+
 /**
  * The HardwareController class is a templated class, it gets templated with an interface type which defines 
  * the communication protocol. 
  */
-template <class InterfaceType> class HardwareController
+template <class InterfaceType> class HardwareController : public ReactorEndpoint
 {
   public:
     HardwareController()
@@ -67,13 +102,18 @@ template <class InterfaceType> class HardwareController
         , watchdog_thread_spawned_(false)
         , stop_watchdog_(false)
         , stop_read_loop_(false) 
+        , read_wait_until_(0)
         , received_controller_id_(-1)
         , received_firmware_major_version_(-1)
         , received_firmware_minor_version_(-1)
         , n_p_(ros::NodeHandle("~"))
+        , pipeline_depth_(HARDWARE_CONTROL_DEFAULT_PIPELINE_DEPTH)
+        , implicit_heartbeat_(false)
+        , heartbeat_idle_time_(HARDWARE_CONTROL_DEFAULT_HEARTBEAT_IDLE_TIME)
     {
         set_name("NONAME");
-        executing_command_mutex_ = boost::shared_ptr<mutex>(new mutex());   
+        dispatcher_ = boost::shared_ptr<CommandDispatcher>(new CommandDispatcher());
+        reactor_frame_parser_ = boost::shared_ptr<FrameParser>(new FrameParser());
     }
 
     HardwareController(string name, InterfaceType communication_interface)
@@ -82,14 +122,19 @@ template <class InterfaceType> class HardwareController
         , watchdog_thread_spawned_(false)
         , stop_watchdog_(false)
         , stop_read_loop_(false)
+        , read_wait_until_(0)
         , received_controller_id_(-1)
         , received_firmware_major_version_(-1)
         , received_firmware_minor_version_(-1)
         , n_p_(ros::NodeHandle("~"))
+        , pipeline_depth_(HARDWARE_CONTROL_DEFAULT_PIPELINE_DEPTH)
+        , implicit_heartbeat_(false)
+        , heartbeat_idle_time_(HARDWARE_CONTROL_DEFAULT_HEARTBEAT_IDLE_TIME)
     {
         set_name("NONAME");
-        set_communication_interface(communication_interface);
-        executing_command_mutex_ = boost::shared_ptr<mutex>(new mutex());
+        set_comm_interface(communication_interface);
+        dispatcher_ = boost::shared_ptr<CommandDispatcher>(new CommandDispatcher());
+        reactor_frame_parser_ = boost::shared_ptr<FrameParser>(new FrameParser());
     }
 
     ~HardwareController()
@@ -119,17 +164,83 @@ template <class InterfaceType> class HardwareController
       return &comm_interface_;
     }
 
+    bool set_pipeline_depth(unsigned int pipeline_depth)
+    {
+      if(pipeline_depth == 0)
+        return false;
+
+      pipeline_depth_ = pipeline_depth;
+      return true;
+    }
+
+    unsigned int get_pipeline_depth()
+    {
+      return pipeline_depth_;
+    }
+
+    void set_queue_limit(CommandPriority priority, uint32_t limit)
+    {
+      dispatcher_->set_queue_limit(priority, limit);
+    }
+
+    // Times a command of the class is written again at once when its response is damaged, instead of timing out
+    void set_retry_limit(CommandPriority priority, uint32_t limit)
+    {
+      dispatcher_->set_retry_limit(priority, limit);
+    }
+
+    uint64_t getNrOfFrameErrors()
+    {
+      return dispatcher_->getNrOfFrameErrors();
+    }
+
+    uint64_t getNrOfDiscardedResponses()
+    {
+      return dispatcher_->getNrOfDiscardedResponses();
+    }
+
+    CommandClassStats getCommandStats(CommandPriority priority)
+    {
+      return dispatcher_->getStats(priority);
+    }
+
+    void resetCommandStats()
+    {
+      dispatcher_->resetStats();
+    }
+
+    // Write, first byte and round trip latency histograms and the timeouts and failed checks per command type
+    std::vector<CommandLatencyStats> getLatencyStats()
+    {
+      return dispatcher_->getLatencyStats();
+    }
+
+    void resetLatencyStats()
+    {
+      dispatcher_->resetLatencyStats();
+    }
+
+    // Responses of this type are streamed by the controller itself, they are handed to the handler instead of to the commands
+    void set_telemetry_handler(int response_type, TelemetryHandler handler)
+    {
+      dispatcher_->set_telemetry_handler(response_type, handler);
+    }
+
+    uint64_t getNrOfTelemetryResponses()
+    {
+      return dispatcher_->getNrOfTelemetryResponses();
+    }
+
     bool checkControllerID(int expected_controller_id)
     {
-        ControllerResponse*     response;
-        ControllerCommand*      command;
-        
+        ControllerIdCommand::Response response;
+
         // Get firmware id
-        response = new ControllerResponse(HARDWARE_CONTROL_ID, HARDWARE_CONTROL_TIMEOUT);
-        response->addExpectedDataItem(ControllerData(expected_controller_id, received_controller_id_));
-        command  = new ControllerCommand(HARDWARE_CONTROL_ID, *response);
+        if(!executeTyped<ControllerIdCommand>(ControllerIdCommand::Request(), response))
+            return false;
 
-        if(!executeCommand(*command))
+        received_controller_id_ = std::get<0>(response);
+        if(received_controller_id_ != expected_controller_id)
         {
             ROS_ERROR_NAMED(ROS_NAME, "Invalid firmware ID detected: %d, expected: %d", received_controller_id_, expected_controller_id);
             return false;
@@ -140,16 +251,15 @@ template <class InterfaceType> class HardwareController
 
     bool checkFirmwareVersion(int expected_firmware_major_version, int expected_firmware_minor_version)
     {
-        ControllerResponse*     response;
-        ControllerCommand*      command;
+        FirmwareVersionCommand::Response response;
 
         // Get firmware version
-        response = new ControllerResponse(HARDWARE_CONTROL_VERSION, HARDWARE_CONTROL_TIMEOUT);
-        response->addExpectedDataItem(ControllerData(expected_firmware_major_version, received_firmware_major_version_));
-        response->addExpectedDataItem(ControllerData(expected_firmware_minor_version, received_firmware_minor_version_));
-        command  = new ControllerCommand(HARDWARE_CONTROL_VERSION, *response);
+        if(!executeTyped<FirmwareVersionCommand>(FirmwareVersionCommand::Request(), response))
+            return false;
 
-        if(!executeCommand(*command))
+        received_firmware_major_version_ = std::get<0>(response);
+        received_firmware_minor_version_ = std::get<1>(response);
+        if(received_firmware_major_version_ != expected_firmware_major_version or received_firmware_minor_version_ != expected_firmware_minor_version)
         {
             ROS_ERROR_NAMED(ROS_NAME, "Invalid firmware version detected: %d.%d, expected: %d.%d",  received_firmware_major_version_, 
                                                                                                     received_firmware_minor_version_, 
@@ -161,7 +271,42 @@ template <class InterfaceType> class HardwareController
         return true;
     }
 
-    bool simpleCommand(string command_string, int timeout)
+    // Asks the controller to switch to another frame format, it answers in the current format and uses the new one
+    // after that. Call after connecting and spawning the read loop, a controller that does not know the command keeps
+    // the ASCII format. Returns false if the link stays in the current format.
+    bool negotiateFrameFormat(FrameFormat frame_format)
+    {
+        if(get_frame_format() == frame_format)
+            return true;
+
+        SetFrameFormatCommand::Response response;
+        CommandTransactionPtr transaction = typedTransaction<SetFrameFormatCommand>(SetFrameFormatCommand::Request(frame_format), response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_SAFETY);
+        transaction->switches_frame_format  = true;
+        transaction->frame_format           = frame_format;
+        transaction->retryable              = true;
+
+        if(!executeTransaction(transaction).success)
+        {
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Controller did not accept frame format %d, continuing with frame format %d.", frame_format, get_frame_format());
+            return false;
+        }
+
+        ROS_DEBUG_NAMED(ROS_NAME_HC,  "Switched to frame format %d.", frame_format);
+        return true;
+    }
+
+    // Only a controller that has been reset has to be told to use the ASCII format again
+    void set_frame_format(FrameFormat frame_format)
+    {
+        dispatcher_->set_frame_format(frame_format);
+    }
+
+    FrameFormat get_frame_format()
+    {
+        return dispatcher_->get_frame_format();
+    }
+
+    bool simpleCommand(string command_string, ControllerTimeout timeout)
     {
         ControllerResponse response(command_string, timeout);
         ControllerCommand  command(command_string, response);
@@ -169,7 +314,7 @@ template <class InterfaceType> class HardwareController
         return executeCommand(command);
     }
 
-    bool simpleCommand(string command_string, int timeout, int data)
+    bool simpleCommand(string command_string, ControllerTimeout timeout, int data)
     {
         ControllerResponse response(command_string, timeout);
         ControllerCommand  command(command_string, response);
@@ -178,90 +323,287 @@ template <class InterfaceType> class HardwareController
         return executeCommand(command);
     }
 
-    bool setValue(string command_string, int timeout, int send_value)
+    bool setValue(string command_string, ControllerTimeout timeout, int send_value)
     {
         ControllerResponse response(command_string, timeout);
         response.addExpectedDataItem(ControllerData(send_value, "Setting value unsuccessfull."));
         ControllerCommand  command(command_string, response);
         command.addDataItem(send_value);
+        command.setRetryable(true);     // Setting the same value twice leaves it the same
 
         return executeCommand(command);
     }
 
-    bool setValue(string command_string, int timeout, int send_value, int& receive_value)
+    bool setValue(string command_string, ControllerTimeout timeout, int send_value, int& receive_value)
     {
         ControllerResponse response(command_string, timeout);
         response.addExpectedDataItem(ControllerData(send_value, receive_value, "Setting value unsuccessfull."));
         ControllerCommand  command(command_string, response);
         command.addDataItem(send_value);
+        command.setRetryable(true);     // Setting the same value twice leaves it the same
 
         return executeCommand(command);
     }
 
-    bool getValue(string command_string, int timeout, int& receive_value)
+    bool getValue(string command_string, ControllerTimeout timeout, int& receive_value)
     {
         ControllerResponse response(command_string, timeout);
         response.addExpectedDataItem(ControllerData(receive_value));
         ControllerCommand  command(command_string, response);
+        command.setRetryable(true);     // A status request can be repeated
 
         return executeCommand(command);
     }
 
-    bool getValue(string command_string, int timeout, const int& send_value, int& receive_value)
+    bool getValue(string command_string, ControllerTimeout timeout, const int& send_value, int& receive_value)
     {
         ControllerResponse response(command_string, timeout);
         response.addExpectedDataItem(ControllerData(receive_value));
         ControllerCommand  command(command_string, response);
         command.addDataItem(send_value);
+        command.setRetryable(true);     // A status request can be repeated
 
         return executeCommand(command);
     }
 
     //! @todo OH: Update this function and ControllerCommand etc. to use (const) references etc.
-    bool executeCommand(ControllerCommand command)
+    bool executeCommand(ControllerCommand command, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
     {
-        // Blocking lock such that only one thread can execute a command at a time
-        // This is neccessary because the watchdog is running in a seperate thread
-        executing_command_mutex_->lock();
-
         ROS_DEBUG_NAMED(ROS_NAME_HC, "Executing command [%s]", command.getSerialMessage().c_str());
-        
-        // Check if the communication interface is connected
-        if(!get_comm_interface()->connect())
+
+        // The dispatcher serializes the commands of all threads, this blocks until this one has been answered
+        return executeTransaction(commandTransaction(command, priority)).success;
+    }
+
+    // Queues the command and returns immediately, the future becomes ready when the command has been answered or
+    // has timed out. Data items that point to a variable are assigned on completion, the variable has to outlive it.
+    std::future<CommandResult> executeCommandAsync(const ControllerCommand& command, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        return submitAsync(commandTransaction(command, priority));
+    }
+
+    // Queues the command and returns immediately, the callback is called on completion from the response read loop 
+    // thread. It may queue further commands but must not wait for them.
+    void executeCommandAsync(const ControllerCommand& command, CommandCallback callback, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        CommandTransactionPtr transaction = commandTransaction(command, priority);
+        transaction->callback = callback;
+        submit(transaction);
+    }
+
+    // Writes the commands back-to-back, keeping at most pipeline_depth_ of them in flight, such that the link 
+    // does not sit idle for a round trip between commands. Returns true if all commands got a correct response.
+    bool executePipelined(std::vector<ControllerCommand>& commands, PipelineMatching matching = PIPELINE_MATCH_IN_ORDER, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        // Only keep the pipeline filled, such that a long list does not exceed the queue limit, which can be lower
+        size_t                                      max_outstanding = std::max<size_t>(1, std::min<size_t>(pipeline_depth_, dispatcher_->get_queue_limit(priority)));
+        std::deque< std::future<CommandResult> >   results;
+        bool                                        all_ok = true;
+        for(auto& command : commands)
         {
-            ROS_WARN_NAMED(ROS_NAME_HC, "Serial not connected, when trying to write command [%s]", command.getSerialMessage().c_str());
-            executing_command_mutex_->unlock();
-            return false;
+            if(results.size() >= max_outstanding)
+            {
+                all_ok = results.front().get().success && all_ok;
+                results.pop_front();
+            }
+
+            CommandTransactionPtr transaction = commandTransaction(command, priority);
+            transaction->pipeline_depth = pipeline_depth_;
+            transaction->match_by_type  = (matching == PIPELINE_MATCH_BY_TYPE);
+            results.push_back(submitAsync(transaction));
         }
-        ROS_DEBUG_NAMED(ROS_NAME_HC,  "Writing: %s", command.getSerialMessage().c_str());
 
-        // Write to the platform
-        if(!get_comm_interface()->writeBlock(command.getSerialMessage().c_str(), command.getSerialMessage().length()))
+        for(auto& result : results)
+            all_ok = result.get().success && all_ok;
+
+        return all_ok;
+    }
+
+    // Encodes all commands into one buffer and writes it with a single write, then collects and checks the 
+    // responses in order. Returns true if all commands got a correct response.
+    bool executeBatch(std::vector<ControllerCommand>& commands, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        if(commands.empty())
+            return true;
+
+        string  batch;
+        string  binary_batch;
+        bool    binary = get_frame_format() == FRAME_FORMAT_BINARY;
+        for(auto& command : commands)
         {
-            ROS_DEBUG_NAMED(ROS_NAME_HC,  "Write of command [%s] failed", command.getSerialMessage().c_str());
-            executing_command_mutex_->unlock();
-            return false;
+            batch += command.getSerialMessage();
+
+            // A batch with a command that can not be encoded is left to the dispatcher to convert, which rejects it
+            binary = binary && command.appendBinaryMessage(binary_batch);
         }
 
-        // Wait for command response
-        if(!waitForResponse(command))
+        // All commands are sent at the same time, their timeouts start at the write. The batch is written again only
+        // if all of its commands may be executed twice.
+        CommandTransactionPtr transaction(new CommandTransaction(batch));
+        transaction->priority   = priority;
+        transaction->retryable  = true;
+        if(binary)
+            transaction->binary_message.swap(binary_batch);
+
+        for(auto& command : commands)
         {
-            executing_command_mutex_->unlock();
-            return false;     
+            transaction->retryable = transaction->retryable && command.isRetryable();
+            ControllerCommand* batched_command = &command;
+            transaction->expectResponse(command.getExpectedResponse(), [this, batched_command](ControllerResponse& response){ return checkResponse(*batched_command, response); });
         }
 
-        executing_command_mutex_->unlock();
+        ROS_DEBUG_NAMED(ROS_NAME_HC,  "Writing batch: %s", batch.c_str());
+        return executeTransaction(transaction).success;
+    }
 
-        return true;
+    // Executes a command declared as TypedCommand, the request is encoded and the response decoded without 
+    // string or list intermediates. Returns true if the response matches the schema of the command.
+    template<class Command>
+    bool executeTyped(  const typename Command::Request&   request, 
+                        typename Command::Response&         response, 
+                        ControllerTimeout                   timeout     = HARDWARE_CONTROL_TIMEOUT, 
+                        CommandPriority                     priority    = COMMAND_PRIORITY_CONTROL)
+    {
+        CommandResult result = executeTransaction(typedTransaction<Command>(request, response, timeout, priority));
+        if(!result.success && !result.timed_out && result.response.get_response() != "")
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Not the correct response [%s] to command %d.", result.response.getPrettyString().c_str(), Command::id);
+
+        return result.success;
+    }
+
+    // Queues a TypedCommand and returns immediately, the response is decoded into the given fields before the 
+    // callback is called, they have to outlive the command.
+    template<class Command>
+    void executeTypedAsync( const typename Command::Request&   request, 
+                            typename Command::Response&         response, 
+                            CommandCallback                     callback, 
+                            ControllerTimeout                   timeout     = HARDWARE_CONTROL_TIMEOUT, 
+                            CommandPriority                     priority    = COMMAND_PRIORITY_CONTROL)
+    {
+        CommandTransactionPtr transaction = typedTransaction<Command>(request, response, timeout, priority);
+        transaction->callback = callback;
+        submit(transaction);
+    }
+
+    // Executes a command of which the frame has been encoded in advance, only the patched data items have been 
+    // encoded since. Returns true if the response passes the check of the template.
+    bool executeTemplate(CommandTemplate& command_template, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        CommandResult result = executeTransaction(templateTransaction(command_template, priority));
+        if(!result.success && !result.timed_out && result.response.get_response() != "")
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Not the correct response [%s] to command %s.", result.response.getPrettyString().c_str(), command_template.getCommand().c_str());
+
+        return result.success;
     }
 
-    // You can do custom stuff in this function
+    // Queues a command of a template and returns immediately, the template has to outlive the command and may 
+    // only be patched again after the callback.
+    void executeTemplateAsync(CommandTemplate& command_template, CommandCallback callback, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+    {
+        CommandTransactionPtr transaction = templateTransaction(command_template, priority);
+        transaction->callback = callback;
+        submit(transaction);
+    }
+
+    // Blocks until the transaction has been completed by the dispatcher
+    CommandResult executeTransaction(const CommandTransactionPtr& transaction)
+    {
+        // Completions are handled by the response read loop or the reactor, they can not wait for them themselves
+        if((responses_read_thread_spawned_ && this_thread::get_id() == responses_read_thread_->get_id()) || (reactor_ != NULL && reactor_->isReactorThread()))
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Waiting for a response from within a completion callback is not possible.");
+            return CommandResult();
+        }
+
+        return submitAsync(transaction).get();
+    }
+
+    std::future<CommandResult> submitAsync(const CommandTransactionPtr& transaction)
+    {
+        boost::shared_ptr< std::promise<CommandResult> > promise(new std::promise<CommandResult>());
+        std::future<CommandResult> future = promise->get_future();
+
+        transaction->callback = [promise](const CommandResult& result){ promise->set_value(result); };
+        submit(transaction);
+
+        return future;
+    }
+
+    // Hands the transaction to the dispatcher, timeouts are reported here for all callers
+    void submit(const CommandTransactionPtr& transaction)
+    {
+        CommandTransaction* submitted   = transaction.get();
+        CommandCallback     callback    = transaction->callback;
+        transaction->callback = [submitted, callback](const CommandResult& result)
+        {
+            if(result.timed_out)
+                ROS_ERROR_NAMED(ROS_NAME_HC,  "TIMEOUT while waiting for response %s", submitted->expected[submitted->n_received - 1].getPrettyString().c_str());
+
+            if(callback)
+                callback(result);
+        };
+
+        if(!dispatcher_->submit(transaction))
+            ROS_ERROR_NAMED(ROS_NAME,  "Command rejected, the response read loop is not enabled or the queue of its priority class is full.");
+    }
+
+    // Creates the transaction of a command, the response is checked against a copy of the command
+    CommandTransactionPtr commandTransaction(const ControllerCommand& command, CommandPriority priority)
+    {
+        boost::shared_ptr<ControllerCommand>    shared_command(new ControllerCommand(command));
+        CommandTransactionPtr                   transaction(new CommandTransaction(shared_command->getSerialMessage()));
+        transaction->priority   = priority;
+        transaction->retryable  = shared_command->isRetryable();
+
+        if(get_frame_format() == FRAME_FORMAT_BINARY)
+            shared_command->appendBinaryMessage(transaction->binary_message);
+
+        transaction->expectResponse(shared_command->getExpectedResponse(), [this, shared_command](ControllerResponse& response){ return checkResponse(*shared_command, response); });
+        return transaction;
+    }
+
+    // Creates the transaction of a TypedCommand, the response is decoded against a copy of the request
+    template<class Command>
+    CommandTransactionPtr typedTransaction(const typename Command::Request& request, typename Command::Response& response, ControllerTimeout timeout, CommandPriority priority)
+    {
+        char        message[Command::max_request_length];
+        uint32_t    message_length = Command::encode(request, message, sizeof(message));
+
+        typename Command::Request   sent_request        = request;
+        typename Command::Response* decoded_response    = &response;
+        CommandTransactionPtr       transaction(new CommandTransaction(message, message_length));
+        transaction->priority = priority;
+        if(get_frame_format() == FRAME_FORMAT_BINARY)
+            Command::appendBinary(request, transaction->binary_message);
+
+        transaction->expectResponse(ControllerResponse(number_codec::intToString(Command::id), timeout), [sent_request, decoded_response](ControllerResponse& received_response)
+        {
+            return Command::decode(received_response, sent_request, *decoded_response);
+        });
+        return transaction;
+    }
+
+    // Creates the transaction of a CommandTemplate, the frame is copied as is and the response is checked by the template
+    CommandTransactionPtr templateTransaction(CommandTemplate& command_template, CommandPriority priority)
+    {
+        CommandTemplate*        checking_template = &command_template;
+        CommandTransactionPtr   transaction(new CommandTransaction(command_template.getMessage(), command_template.getMessageLength()));
+        transaction->priority   = priority;
+        transaction->retryable  = command_template.isRetryable();
+        if(get_frame_format() == FRAME_FORMAT_BINARY)
+            transaction->binary_message = command_template.getBinaryMessage();
+
+        transaction->expectResponse(command_template.getExpectedResponse(), [checking_template](ControllerResponse& response){ return checking_template->checkResponse(response); });
+        return transaction;
+    }
+
+    // You can do custom stuff in this function, it gets the responses that no telemetry handler or command is waiting for
     virtual bool handleResponse(ControllerResponse response)
     {
-        return true;
+        return false;
     }
 
-    bool checkResponse(ControllerCommand command, ControllerResponse response)
+    bool checkResponse(ControllerCommand& command, ControllerResponse& response)
     {
         //  Check for unkown command response
         if(command.getCommand() == HARDWARE_CONTROL_UNKOWN_COMMAND)
@@ -270,42 +612,50 @@ template <class InterfaceType> class HardwareController
             return false;
         }
 
+        ControllerResponse& expected_response = command.getExpectedResponse();
+
         // Check if the received response is of the correct type (number)
-        if(command.getExpectedResponse().get_type() == response.get_type()) 
+        if(expected_response.hasSameType(response)) 
         {       
             // A command could be a order or a status request, check the returned data items accordingly
             // An order will have to return the given parameters in the same sequence
             // A status request will have to set the values of the variables it is associated with.
             // Therefore a data item will have to have a pointer to this variable when doing a status request
-            list<ControllerData> expected_response_data  = command.getExpectedResponse().getExpectedDataItems();
-            list<ControllerData> response_data           = response.getReceivedDataItems();            
+            list<ControllerData>&   expected_response_data  = expected_response.getExpectedDataItems();
+            uint32_t                nr_of_data_items        = response.getNrOfReceivedDataItems();
    
             // Check if the number of received and expected data items is the same
-            if(expected_response_data.size() != response_data.size())
+            if(expected_response_data.size() != nr_of_data_items)
             {
-                ROS_WARN_NAMED(ROS_NAME_HC,  "Received incorrect number of dataitems (%lu received, expected %lu) for command %s.", response_data.size(), expected_response_data.size(), command.getCommand().c_str());
+                ROS_WARN_NAMED(ROS_NAME_HC,  "Received incorrect number of dataitems (%u received, expected %lu) for command %s.", nr_of_data_items, expected_response_data.size(), command.getCommand().c_str());
                 return false;
             }
 
             // Loop through the data items
-            bool all_data_ok            = true;
-            auto it_expected_response   = expected_response_data.begin();
-            for(auto it_response = response_data.begin(); it_response != response_data.end(); it_response++)
+            bool        all_data_ok             = true;
+            uint32_t    index                   = 0;
+            for(auto it_expected_response = expected_response_data.begin(); it_expected_response != expected_response_data.end(); it_expected_response++)
             { 
                 // If the pointer is not NULL assign the data                
                 if(it_expected_response->getDataPointer() != NULL)
                 {
-                    if(!assignPointedValue(it_expected_response->getDataPointer(), it_response->getData()))        
-                        return false;
+                    if(!response.getReceivedDataItemInt(index, it_expected_response->getDataPointer()))
+                    {
+                        uint32_t length;
+                        const char* data = response.getReceivedDataItem(index, &length);
+                        ROS_ERROR_NAMED(ROS_NAME_HC,  "Trying to assign integer value from a controller response but the recevied data is not a number: '%s'", string(data, length).c_str());
+                    }
                 }
 
                 // Check if we are expecting a specific response
                 if(it_expected_response->getData() != "")
                 {
                     // Check if we received this specific data
-                    if(it_expected_response->getData() != it_response->getData())
+                    if(!response.receivedDataItemEquals(index, it_expected_response->getData()))
                     {
-                        ROS_WARN_NAMED(ROS_NAME_HC,  "Wrong data value echoed back whilst issuing an order(%s), expected: %s, received: %s", command.getCommand().c_str(), it_expected_response->getData().c_str(), it_response->getData().c_str());
+                        uint32_t length;
+                        const char* data = response.getReceivedDataItem(index, &length);
+                        ROS_WARN_NAMED(ROS_NAME_HC,  "Wrong data value echoed back whilst issuing an order(%s), expected: %s, received: %s", command.getCommand().c_str(), it_expected_response->getData().c_str(), string(data, length).c_str());
                         // Display custum error message
                         if(it_expected_response->getErrorMessage() != "")
                             ROS_WARN_NAMED(ROS_NAME_HC,  "%s", it_expected_response->getErrorMessage().c_str());
@@ -315,8 +665,8 @@ template <class InterfaceType> class HardwareController
                     }
                 }                
                 
-                // Increase iterator pointer unit
-                it_expected_response++;
+                // Increase data item index
+                index++;
             } 
 
 
@@ -325,7 +675,7 @@ template <class InterfaceType> class HardwareController
         }
         else
         {
-            ROS_WARN_NAMED(ROS_NAME_HC,  "Not the correct response [%s], expected [%s].", response.getPrettyString().c_str(), command.getExpectedResponse().getPrettyString().c_str());
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Not the correct response [%s], expected [%s].", response.getPrettyString().c_str(), expected_response.getPrettyString().c_str());
         }
 
         return false;
@@ -334,91 +684,77 @@ template <class InterfaceType> class HardwareController
     bool assignPointedValue(int* pointer, string value)
     {
         // Assign received value, for now always an integer
-        try{
-            *pointer = rose_conversions::stringToInt(value);
+        CodecStatus status = number_codec::decodeInt(value, pointer);
+        if(status == CODEC_OK)
             ROS_DEBUG_NAMED(ROS_NAME_HC,  "Assigned integer value '%d' from a controller response: '%s'", *pointer, value.c_str());
-            return true;
-        }
-        catch (...) {
-          ROS_ERROR_NAMED(ROS_NAME_HC,  "Trying to assign integer value from a controller response but the recevied data is not a number: '%s'", value.c_str());
-        }   
+        else
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Trying to assign integer value from a controller response but the recevied data is not a number (%s): '%s'", number_codec::statusString(status), value.c_str());
+
         return true;
     }
 
-    bool waitForResponse(ControllerCommand command)
+    // Time the response read loop may wait for data, until the first deadline of the commands in flight or until a
+    // started frame is taken as damaged. Without either it waits until data arrives or a written command wakes it.
+    uint32_t readWait(std::chrono::steady_clock::time_point frame_gap_deadline)
     {
-        if(!responses_read_thread_spawned_)
-        {
-            ROS_ERROR_NAMED(ROS_NAME,  "Waiting for repsonse without response read loop enabled.");
-            return false;
-        }
-
-        bool correct_response_received  = false;
-        ros::Time begin                 = ros::Time::now();
-        int sec_waiting                 = 0;
-        
-        do
-        {
-            ROS_DEBUG_THROTTLE_NAMED(0.1, ROS_NAME_HC, "Waiting for response (%s)... (%ds of %ds)", command.getExpectedResponse().getPrettyString().c_str(), sec_waiting, command.getExpectedResponse().get_timeout());    
-
-            if(!responses_.empty())
-            {                
-                ControllerResponse front_response = responses_.front();
-
-                ROS_DEBUG_NAMED(ROS_NAME_HC,  "Response received: %s", front_response.getPrettyString().c_str()); 
-
-                if(checkResponse(command, front_response))
-                {
-                    ROS_DEBUG_NAMED(ROS_NAME_HC,  "Correct response received: %s", front_response.getPrettyString().c_str()); 
-                    // Handle the response
-                    // Break out of the while loop!
-                    responses_.pop();    
-                    return true;             
-                }  
-                else
-                {
-                    responses_.pop();     
-                    return false;
-                }
-                 
-            }
-            else
-               ros::Duration(0.002).sleep();
-
-            // Check if timeout has expired
-            sec_waiting = ros::Time::now().toSec() - begin.toSec();
-            if(sec_waiting >= command.getExpectedResponse().get_timeout())
-            {
-                ROS_ERROR_NAMED(ROS_NAME_HC,  "TIMEOUT(%ds) while waiting for response %s", command.getExpectedResponse().get_timeout(), command.getExpectedResponse().getPrettyString().c_str());
-                return false;
-            }      
-            
-        }while(sec_waiting < command.getExpectedResponse().get_timeout());
+        // Published before the deadlines are read, a command written after that wakes the loop
+        read_wait_until_.store(std::chrono::steady_clock::time_point::max().time_since_epoch().count());
+
+        std::chrono::steady_clock::time_point   now         = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point   deadline    = std::min(dispatcher_->nextDeadline(), frame_gap_deadline);
+        read_wait_until_.store(deadline.time_since_epoch().count());
+        if(deadline == std::chrono::steady_clock::time_point::max())
+            return HARDWARE_COMM_WAIT_FOREVER;
+        if(deadline <= now)
+            return 0;
+
+        return std::min<int64_t>(HARDWARE_COMM_WAIT_FOREVER - 1, std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count() + 1);
+    }
 
-        return false;
+    // Wakes the response read loop when a written command has to time out before the loop looks again
+    void handleDeadline(std::chrono::steady_clock::time_point deadline)
+    {
+        if(deadline.time_since_epoch().count() < read_wait_until_.load())
+            get_comm_interface()->interruptWait();
     }
 
-    
     bool spawnReadloop()
     {
-        if(responses_read_thread_spawned_ == true)
+        if(responses_read_thread_spawned_ == true || reactor_ != NULL)
         {
             ROS_DEBUG_NAMED(ROS_NAME_HC,  "responsesReadloop already spawned");
             return true;
         }
+        else if(get_comm_interface()->isReadExternally())
+        {
+            // A private reactor, its thread does all reading and writing
+            ROS_DEBUG_NAMED(ROS_NAME_HC,  "Attaching to a private reactor");
+            return attachReactor(boost::shared_ptr<IoReactor>(new IoReactor(1)));
+        }
         else
         {
             stop_read_loop_mutex_   = boost::shared_ptr<mutex>(new mutex());
 
+            dispatcher_->set_comm_interface(get_comm_interface());
+            dispatcher_->set_deadline_notifier(std::bind(&HardwareController::handleDeadline, this, std::placeholders::_1));
+            dispatcher_->start();
+
             ROS_DEBUG_NAMED(ROS_NAME_HC,  "Spawning responsesReadloop");
             responses_read_thread_          = boost::shared_ptr<thread>(new thread(&HardwareController::responsesReadloop, this));
-
             responses_read_thread_spawned_  = true;
         }
+
+        return true;
     }
 
     void stopReadloop()
     {
+        if(reactor_ != NULL)
+        {
+            detachReactor();
+            return;
+        }
+
         if(stop_read_loop_mutex_ == NULL || responses_read_thread_spawned_ == false)
             return;
 
@@ -428,23 +764,81 @@ template <class InterfaceType> class HardwareController
         stop_read_loop_         = true;
         stop_read_loop_mutex_->unlock();
 
+        // The read loop can be waiting for data without a deadline
+        get_comm_interface()->interruptWait();
         responses_read_thread_->join();
         responses_read_thread_spawned_ = false;
 
+        // Nothing completes the commands left in the dispatcher anymore
+        dispatcher_->stop();
+        dispatcher_->set_deadline_notifier(DeadlineNotifier());
+
         stop_read_loop_mutex_->lock();
         stop_read_loop_         = false;
         stop_read_loop_mutex_->unlock();
     }
 
-    // Gets the buffer from the serial interface, and take apart into $ seperated messages
-    void responsesReadloop()
+    /**
+     * Lets a reactor, possibly shared with other controllers, do all reading and writing instead of the response 
+     * read loop. The communication interface has to be read externally.
+     * @param[in] boost::shared_ptr<IoReactor> reactor, the reactor to attach to.
+     * @return false if the controller already reads its responses or could not be added to the reactor.
+     */
+    bool attachReactor(boost::shared_ptr<IoReactor> reactor)
+    {
+        if(responses_read_thread_spawned_ == true || reactor_ != NULL)
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Can not attach to a reactor, the responses are already read.");
+            return false;
+        }
+
+        if(!get_comm_interface()->isReadExternally())
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Can not attach to a reactor, the communication interface is not read externally.");
+            return false;
+        }
+
+        reactor_frame_parser_->reset();
+        dispatcher_->set_comm_interface(get_comm_interface());
+        dispatcher_->start();
+        dispatcher_->set_write_notifier(std::bind(&IoReactor::wake, reactor.get(), this));
+
+        reactor_ = reactor;
+        if(!reactor_->addEndpoint(this))
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Could not add the controller to the reactor.");
+            dispatcher_->set_write_notifier(std::function<void()>());
+            dispatcher_->stop();
+            reactor_.reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    void detachReactor()
     {
-        deque<char>                 serial_buffer;
-        ControllerResponse*         cur_response        = new ControllerResponse();
-        thread_safe::deque<char>    latest_serial_data  = *new thread_safe::deque<char>();
+        if(reactor_ == NULL)
+            return;
+
+        ROS_DEBUG_NAMED(ROS_NAME_HC,  "Detaching from the reactor");
 
-        ros::Time start_time_;
-        ros::Time end_time_;
+        // Not called by the reactor anymore after this
+        reactor_->removeEndpoint(this);
+
+        // Nothing completes the commands left in the dispatcher anymore
+        dispatcher_->stop();
+        dispatcher_->set_write_notifier(std::function<void()>());
+        reactor_.reset();
+    }
+
+    // Borrows the received bytes from the serial interface, and take apart into $ seperated messages
+    void responsesReadloop()
+    {
+        FrameParser                             frame_parser;
+        const char*                             serial_data;
+        uint32_t                                serial_data_length;
+        std::chrono::steady_clock::time_point   frame_gap_deadline = std::chrono::steady_clock::time_point::max();
 
         bool local_stop_read_loop_ = false;
         
@@ -452,85 +846,159 @@ template <class InterfaceType> class HardwareController
         
         while(!local_stop_read_loop_)
         {
-            start_time_ = ros::Time::now();
-
             stop_read_loop_mutex_->lock();
             local_stop_read_loop_ = stop_read_loop_;
             stop_read_loop_mutex_->unlock();
 
             if(get_comm_interface()->is_ok())
             {
-                if(serial_buffer.empty())
-                {
-                    // Get latest data and append to the local serial_buffers                  
-                    if(get_comm_interface()->fetchBuffer(&latest_serial_data))
-                    {
-                        serial_buffer.insert(serial_buffer.end(), latest_serial_data.begin(), latest_serial_data.end());                    
-                        latest_serial_data.clear();
-                    }
-                    else
-                        ros::Duration(0.002).sleep();                            
-                }
-                else
-                {    
-                    // Get the first character in the buffer
-                    char cur_character = serial_buffer.front();
-                    serial_buffer.pop_front();
-                    switch(cur_character)            
-                    {                
-                        case '$':
-                               ROS_DEBUG_NAMED(ROS_NAME_HC,  "$ received -> starting new response");
-                            cur_response = new ControllerResponse();
-                            break;
-                        case '\n':
-                        case '\r':
-                               ROS_DEBUG_NAMED(ROS_NAME_HC,  "NEWLINE received -> Response received: %s", cur_response->getPrettyString().c_str());
-
-                            responses_.push(*cur_response);
-
-                            cur_response = new ControllerResponse();
-                            break;
-                        default:
-                               ROS_DEBUG_NAMED(ROS_NAME_HC,  "Adding character '%c' to response", cur_character);
-                            cur_response->addCharacter(cur_character);
-                            break;
-                    }; 
-                }   
+                // Borrow the latest data directly from the interface
+                serial_data_length = get_comm_interface()->borrowBuffer(&serial_data);
+                if(serial_data_length == 0 && !local_stop_read_loop_)
+                    get_comm_interface()->waitForData(readWait(frame_gap_deadline));
+
+                dispatchResponses(frame_parser, serial_data, serial_data_length);
+                get_comm_interface()->commitBuffer(serial_data_length);
             }
 
-            end_time_ = ros::Time::now();
-            ros::Duration d = end_time_ - start_time_; 
-         //   ROS_INFO("responsesReadloop time: %.5f rate: %.2f", d.toSec(), 1.0/d.toSec());    
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            dispatcher_->handleTimeouts(now);
+            frame_gap_deadline = checkFrameGap(frame_parser, now);
         }   
+    }
+
+    // Takes the received bytes apart into frames and hands the responses to the dispatcher
+    void dispatchResponses(FrameParser& frame_parser, const char* data, uint32_t length)
+    {
+        bool        frame_complete;
+        uint32_t    n_parsed = 0;
+        if(length > 0)
+        {
+            last_byte_time_ = std::chrono::steady_clock::now();
+            dispatcher_->handleBytesReceived(last_byte_time_);
+        }
 
-        // Cleanup
-        do
+        while(n_parsed < length)
         {
-            if(!responses_.empty())
-                responses_.pop();
-        } while(!responses_.empty());
+            // A response may have switched the frame format of the bytes after it
+            frame_parser.set_frame_format(dispatcher_->get_frame_format());
+
+            // A dropped frame lets the command in flight be written again, instead of waiting for its timeout
+            uint64_t n_dropped = frame_parser.get_dropped_count();
+            n_parsed += frame_parser.parse(data + n_parsed, length - n_parsed, &frame_complete);
+            if(frame_parser.get_dropped_count() != n_dropped)
+            {
+                ROS_WARN_NAMED(ROS_NAME_HC,  "Dropped a damaged frame.");
+
+                // A frame that lost its terminator still tells its type
+                ControllerResponse damaged;
+                if(frame_parser.getTruncatedFrameLength() > 0)
+                    damaged.set_response(frame_parser.getFrame(), frame_parser.getTruncatedFrameLength());
+                dispatcher_->handleFrameError(damaged);
+            }
+
+            if(frame_complete)
+            {
+                ControllerResponse response;
+                if(frame_parser.get_frame_format() == FRAME_FORMAT_ASCII)
+                    response.set_response(frame_parser.getFrame(), frame_parser.getFrameLength());
+                else if(!response.set_binary_response(frame_parser.getFrame(), frame_parser.getFrameLength()))
+                {
+                    ROS_WARN_NAMED(ROS_NAME_HC,  "Received binary message of invalid length %u.", frame_parser.getFrameLength());
+                    dispatcher_->handleFrameError();
+                    continue;
+                }
+
+                ROS_DEBUG_NAMED(ROS_NAME_HC,  "Response received: %s", response.getPrettyString().c_str());
+                if(!dispatcher_->handleResponse(response) && !handleResponse(response))
+                    ROS_WARN_NAMED(ROS_NAME_HC,  "Received response [%s] while no command is waiting for it.", response.getPrettyString().c_str());
+            }
+        }
+    }
+
+    // ReactorEndpoint, called by the reactor one at a time
+    int getPollDescriptor()
+    {
+        return get_comm_interface()->getPollDescriptor();
+    }
+
+    void handleReadable()
+    {
+        // Read straight into the frame parser
+        char    buffer[HARDWARE_CONTROL_REACTOR_READ_SIZE];
+        int     n_read = get_comm_interface()->readBlock(buffer, sizeof(buffer));
+        if(n_read > 0)
+            dispatchResponses(*reactor_frame_parser_, buffer, n_read);
+    }
+
+    void handleHangup()
+    {
+        // Reconnected when the next command is written
+        ROS_WARN_NAMED(ROS_NAME_HC,  "Communication interface hung up.");
+        get_comm_interface()->disconnect();
+        reactor_frame_parser_->reset();
+    }
+
+    void handleWake()
+    {
+        dispatcher_->flush();
+    }
+
+    std::chrono::steady_clock::time_point handleTimeouts(std::chrono::steady_clock::time_point now)
+    {
+        dispatcher_->handleTimeouts(now);
+        return std::min(dispatcher_->nextDeadline(), checkFrameGap(*reactor_frame_parser_, now));
+    }
+
+    // Drops a frame of which the rest did not arrive in time, the terminator may have been lost. Returns when to check again.
+    std::chrono::steady_clock::time_point checkFrameGap(FrameParser& frame_parser, std::chrono::steady_clock::time_point now)
+    {
+        if(!frame_parser.isInFrame())
+            return std::chrono::steady_clock::time_point::max();
+
+        std::chrono::steady_clock::time_point deadline = last_byte_time_ + std::chrono::milliseconds(HARDWARE_CONTROL_FRAME_GAP);
+        if(deadline > now)
+            return deadline;
+
+        ROS_WARN_NAMED(ROS_NAME_HC,  "Dropped an unterminated frame.");
+        ControllerResponse damaged;
+        if(frame_parser.get_frame_format() == FRAME_FORMAT_ASCII)
+            damaged.set_response(frame_parser.getFrame(), frame_parser.getFrameLength());
+        frame_parser.reset();
+        dispatcher_->handleFrameError(damaged);
+        return std::chrono::steady_clock::time_point::max();
     }
 
     bool setWatchdogTreshold(int treshold)
     {
-        return setValue(HARDWARE_CONTROL_SET_WATCHDOG_TRESHOLD, HARDWARE_CONTROL_TIMEOUT, treshold, watchdog_treshold_);
+        SetWatchdogTresholdCommand::Response response;
+        if(!executeTyped<SetWatchdogTresholdCommand>(SetWatchdogTresholdCommand::Request(treshold), response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_SAFETY))
+            return false;
+
+        watchdog_treshold_ = treshold;
+        return true;
     }
 
     bool getWatchdogTreshold()
     {
-        return getValue(HARDWARE_CONTROL_GET_WATCHDOG_TRESHOLD, HARDWARE_CONTROL_TIMEOUT, watchdog_treshold_);
+        GetWatchdogTresholdCommand::Response response;
+        if(!executeTyped<GetWatchdogTresholdCommand>(GetWatchdogTresholdCommand::Request(), response))
+            return false;
+
+        watchdog_treshold_ = std::get<0>(response);
+        return true;
     }
 
     bool updateTimers()
     {
-        int nr_timers = 0;
-
-        if( not getValue(HARDWARE_CONTROL_GET_NR_OF_TIMERS, HARDWARE_CONTROL_TIMEOUT, nr_timers))
+        GetNrOfTimersCommand::Response nr_timers_response;
+        if( not executeTyped<GetNrOfTimersCommand>(GetNrOfTimersCommand::Request(), nr_timers_response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_BULK))
         {
             ROS_ERROR_NAMED(ROS_NAME, "Could not retreive number of hardware timers.");
             return false;
         }
 
+        int nr_timers = std::get<0>(nr_timers_response);
         if(nr_timers < 0 or nr_timers > 1000)
         {
             ROS_ERROR_NAMED(ROS_NAME, "Received nr of timer is unreasonable (%d).", nr_timers);
@@ -539,20 +1007,23 @@ template <class InterfaceType> class HardwareController
 
         timers.resize(nr_timers);
 
+        // Get the set and current value of each timer
+        GetTimersCommand::Response timers_response;
+        if( not executeTyped<GetTimersCommand>(GetTimersCommand::Request(), timers_response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_BULK))
+            return false;
 
-        // Get firmware version
-        ControllerResponse response = ControllerResponse(HARDWARE_CONTROL_GET_TIMERS, HARDWARE_CONTROL_TIMEOUT);
-        int i = 0;
-        for(auto& timer : timers)
+        RepeatedField& values = std::get<0>(timers_response);
+        if(values.size() != 2 * timers.size())
         {
-            response.addExpectedDataItem(ControllerData(timers[i].set_value));
-            response.addExpectedDataItem(ControllerData(timers[i++].cur_value));
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Received incorrect number of timer values (%lu received, expected %lu).", values.size(), 2 * timers.size());
+            return false;
         }
 
-        ControllerCommand command  = ControllerCommand(HARDWARE_CONTROL_GET_TIMERS, response);
-
-        if( not executeCommand(command))
-            return false;
+        for(size_t i = 0; i < timers.size(); i++)
+        {
+            timers[i].set_value = values[2 * i];
+            timers[i].cur_value = values[2 * i + 1];
+        }
 
         return true;
     }
@@ -579,6 +1050,57 @@ template <class InterfaceType> class HardwareController
         return s;
     }
 
+    // Asks the controller to take every command as heartbeat, the watchdog command is then only sent when the link has
+    // been idle for idle_time. Call before spawnWatchdog(). A controller that does not know the command keeps getting
+    // the watchdog command at the watchdog rate, false is returned then.
+    bool enableImplicitHeartbeat(std::chrono::milliseconds idle_time = std::chrono::milliseconds(HARDWARE_CONTROL_DEFAULT_HEARTBEAT_IDLE_TIME))
+    {
+        if(watchdog_thread_spawned_)
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Can not change the heartbeat while the watchdog runs.");
+            return false;
+        }
+
+        // The watchdog command has to go out before the treshold of the controller, also when checked a period late
+        if(idle_time + std::chrono::milliseconds(1000 / HARDWARE_CONTROL_WATCHDOG_RATE) >= std::chrono::milliseconds(HARDWARE_CONTROL_DEFAULT_WATCHDOG_TIMEOUT))
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Heartbeat idle time of %ld ms does not fit in the watchdog treshold of %d ms.", (long)idle_time.count(), HARDWARE_CONTROL_DEFAULT_WATCHDOG_TIMEOUT);
+            return false;
+        }
+
+        SetImplicitHeartbeatCommand::Response response;
+        if(!executeTyped<SetImplicitHeartbeatCommand>(SetImplicitHeartbeatCommand::Request(1), response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_SAFETY))
+        {
+            ROS_WARN_NAMED(ROS_NAME_HC,  "Controller does not support an implicit heartbeat, sending the watchdog command at %d Hz.", HARDWARE_CONTROL_WATCHDOG_RATE);
+            return false;
+        }
+
+        implicit_heartbeat_     = true;
+        heartbeat_idle_time_    = idle_time;
+        return true;
+    }
+
+    bool disableImplicitHeartbeat()
+    {
+        if(watchdog_thread_spawned_)
+        {
+            ROS_ERROR_NAMED(ROS_NAME_HC,  "Can not change the heartbeat while the watchdog runs.");
+            return false;
+        }
+
+        SetImplicitHeartbeatCommand::Response response;
+        if(!executeTyped<SetImplicitHeartbeatCommand>(SetImplicitHeartbeatCommand::Request(0), response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_SAFETY))
+            return false;
+
+        implicit_heartbeat_ = false;
+        return true;
+    }
+
+    bool isImplicitHeartbeatEnabled()
+    {
+        return implicit_heartbeat_;
+    }
+
     bool spawnWatchdog()
     {
         if(watchdog_thread_spawned_ == true)
@@ -663,21 +1185,20 @@ template <class InterfaceType> class HardwareController
             local_stop_watchdog_ = stop_watchdog_;
             stop_watchdog_mutex_->unlock();
 
-            if(get_comm_interface()->is_ok() && watchdog_ok_)
+            // Other commands have been the heartbeat recently, the link is known to work
+            bool link_busy = implicit_heartbeat_ && std::chrono::steady_clock::now() - dispatcher_->getLastExchangeTime() < heartbeat_idle_time_;
+
+            if(get_comm_interface()->is_ok() && watchdog_ok_ && !link_busy)
             {   
-                ControllerResponse*     response;
-                ControllerCommand*      command;
-      
-                // Drive motor
-                response = new ControllerResponse(HARDWARE_CONTROL_WATCHDOG, HARDWARE_CONTROL_TIMEOUT);
-                response->addExpectedDataItem(ControllerData(received_watchdog_));
-                response->addExpectedDataItem(ControllerData(received_watchdog_cnt_));
-                response->addExpectedDataItem(ControllerData());
-                response->addExpectedDataItem(ControllerData());
-                command  = new ControllerCommand(HARDWARE_CONTROL_WATCHDOG, *response);
-                command->addDataItem(watchdog_);
-
-                if(!executeCommand(*command) || received_watchdog_ != expected_watchdog_)
+                WatchdogCommand::Response response;
+                bool executed = executeTyped<WatchdogCommand>(WatchdogCommand::Request(watchdog_), response, HARDWARE_CONTROL_TIMEOUT, COMMAND_PRIORITY_SAFETY);
+                if(executed)
+                {
+                    received_watchdog_      = std::get<0>(response);
+                    received_watchdog_cnt_  = std::get<1>(response);
+                }
+
+                if(!executed || received_watchdog_ != expected_watchdog_)
                 {
                     if(received_watchdog_ != expected_watchdog_)
                         ROS_ERROR_NAMED(ROS_NAME_HC,  "Watchdog error(%d), wrong response received (received: %d, expected: %d).", received_watchdog_cnt_, received_watchdog_, expected_watchdog_);
@@ -714,14 +1235,18 @@ template <class InterfaceType> class HardwareController
     ros::NodeHandle                         n_;
     ros::NodeHandle                         n_p_;
 
-    boost::shared_ptr<mutex>                executing_command_mutex_;
+    boost::shared_ptr<CommandDispatcher>    dispatcher_;            // Owns the link, serializes the commands of all threads
+    unsigned int                            pipeline_depth_;
 
     bool                                    responses_empty_;
     boost::shared_ptr<thread>               responses_read_thread_;
-    thread_safe::queue<ControllerResponse>  responses_; 
+    boost::shared_ptr<IoReactor>            reactor_;                   // Reads and writes instead of the response read loop
+    boost::shared_ptr<FrameParser>          reactor_frame_parser_;
+    std::chrono::steady_clock::time_point   last_byte_time_;            // Of the reader, to detect a frame that stopped arriving
     bool                                    responses_read_thread_spawned_;
     bool                                    stop_read_loop_;
     boost::shared_ptr<mutex>                stop_read_loop_mutex_;
+    std::atomic<int64_t>                    read_wait_until_;           // Deadline the response read loop waits for, in steady_clock ticks
 
     boost::shared_ptr<thread>               watchdog_thread_;
     bool                                    watchdog_thread_spawned_;
@@ -734,6 +1259,8 @@ template <class InterfaceType> class HardwareController
     int     received_watchdog_;
     bool    watchdog_ok_;
     int     watchdog_treshold_;
+    bool                        implicit_heartbeat_;    // Any command resets the watchdog of the controller
+    std::chrono::milliseconds   heartbeat_idle_time_;
 
     int     received_controller_id_;
     int     received_firmware_major_version_;
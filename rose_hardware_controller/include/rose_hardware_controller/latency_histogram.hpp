@@ -0,0 +1,143 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Lock-free latency histograms with logarithmic buckets, recorded per command
+* 	type for the write time, the time to the first received byte and the round
+* 	trip of the commands to a low-level controller.
+*
+***********************************************************************************/
+
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <limits.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 	4		// Linear sub buckets per power of two, a relative precision of 1/16
+#define LATENCY_HISTOGRAM_MAX_EXPONENT 		24		// Larger latencies are counted in the last bucket, 2^25 us is about 33 s
+#define LATENCY_HISTOGRAM_SUB_BUCKETS 		(1 << LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define LATENCY_HISTOGRAM_NR_OF_BUCKETS 	(2 * LATENCY_HISTOGRAM_SUB_BUCKETS + (LATENCY_HISTOGRAM_MAX_EXPONENT - LATENCY_HISTOGRAM_SUB_BUCKET_BITS) * LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+#define COMMAND_LATENCY_MAX_COMMANDS 		32		// Command types with their own histograms, the others share one
+#define COMMAND_LATENCY_OTHER_ID 			-1		// Command types that are not a number or did not fit
+#define COMMAND_LATENCY_FREE_ID 			INT_MIN
+
+/**
+ * Copy of the counts of a histogram, taken while it is being recorded to.
+ */
+struct LatencyHistogramSnapshot
+{
+	LatencyHistogramSnapshot();
+
+	/**
+	 * @param[in] double percentile, between 0 and 100.
+	 * @return The upper bound of the bucket holding the percentile, 0 if nothing has been recorded.
+	 */
+	std::chrono::microseconds 	getPercentile(double percentile) const;
+	//! @return The mean of the recorded latencies, 0 if nothing has been recorded.
+	std::chrono::microseconds 	getMean() const;
+
+	uint64_t 					count;
+	std::chrono::microseconds 	total;
+	std::chrono::microseconds 	min;
+	std::chrono::microseconds 	max;
+	std::vector<uint64_t> 		buckets;
+};
+
+/**
+ * LatencyHistogram class, latencies below 2 * LATENCY_HISTOGRAM_SUB_BUCKETS us are counted exactly, larger ones
+ * in LATENCY_HISTOGRAM_SUB_BUCKETS linear buckets per power of two. Recording is wait-free and may be done from
+ * any number of threads at the same time as taking snapshots.
+ */
+class LatencyHistogram
+{
+  public:
+	LatencyHistogram();
+
+	void 						record(std::chrono::microseconds latency);
+	LatencyHistogramSnapshot 	snapshot() const;
+	//! Latencies recorded during the reset may be kept partially.
+	void 						reset();
+
+	static uint32_t 			bucketIndex(uint64_t latency_us);
+	//! @return The largest latency in us counted in the bucket.
+	static uint64_t 			bucketUpperBound(uint32_t index);
+
+  private:
+	LatencyHistogram(const LatencyHistogram&);
+	LatencyHistogram& operator=(const LatencyHistogram&);
+
+	std::atomic<uint64_t> 		buckets_[LATENCY_HISTOGRAM_NR_OF_BUCKETS];
+	std::atomic<uint64_t> 		count_;
+	std::atomic<uint64_t> 		total_;
+	std::atomic<uint64_t> 		min_;
+	std::atomic<uint64_t> 		max_;
+};
+
+/**
+ * Timing statistics of a command type.
+ */
+struct CommandLatencyStats
+{
+	CommandLatencyStats();
+
+	int 						command_id;			// The response type, COMMAND_LATENCY_OTHER_ID for the shared histograms
+	LatencyHistogramSnapshot 	write_time;			// Duration of the write to the communication interface
+	LatencyHistogramSnapshot 	first_byte_time;	// From the end of the write until the first byte was received
+	LatencyHistogramSnapshot 	round_trip_time;	// From the end of the write until the response was received
+	uint64_t 					n_timeouts;
+	uint64_t 					n_check_failures;	// Received responses that did not pass their check
+};
+
+/**
+ * CommandLatencyTable class, a fixed table of latency histograms per command type. Command types claim a slot
+ * on their first record, without locking.
+ */
+class CommandLatencyTable
+{
+  public:
+	CommandLatencyTable();
+	~CommandLatencyTable();
+
+	void 		recordWriteTime(int command_id, std::chrono::microseconds latency);
+	void 		recordFirstByteTime(int command_id, std::chrono::microseconds latency);
+	void 		recordRoundTripTime(int command_id, std::chrono::microseconds latency);
+	void 		recordTimeout(int command_id);
+	void 		recordCheckFailure(int command_id);
+
+	//! @return The statistics of all command types recorded since their slot was claimed, ordered by slot.
+	std::vector<CommandLatencyStats> 	snapshot() const;
+	//! Clears the statistics, the command types keep their slot.
+	void 		reset();
+
+  private:
+	CommandLatencyTable(const CommandLatencyTable&);
+	CommandLatencyTable& operator=(const CommandLatencyTable&);
+
+	struct Slot
+	{
+		Slot();
+
+		std::atomic<int> 		command_id;		// COMMAND_LATENCY_FREE_ID until claimed
+		LatencyHistogram 		write_time;
+		LatencyHistogram 		first_byte_time;
+		LatencyHistogram 		round_trip_time;
+		std::atomic<uint64_t> 	n_timeouts;
+		std::atomic<uint64_t> 	n_check_failures;
+	};
+
+	Slot& 		slot(int command_id);
+
+	Slot* 		slots_;			// COMMAND_LATENCY_MAX_COMMANDS slots and the shared slot
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
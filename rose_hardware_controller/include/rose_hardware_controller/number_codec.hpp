@@ -0,0 +1,58 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Non-throwing, locale independent and allocation free conversion between integers
+* 	and their decimal representation, in the style of std::to_chars/from_chars.
+* 
+***********************************************************************************/
+
+#ifndef NUMBER_CODEC_HPP
+#define NUMBER_CODEC_HPP
+
+#include <stdint.h>
+
+#include <string>
+
+#define NUMBER_CODEC_MAX_INT_LENGTH		11		// Sign and 10 digits
+
+/**
+ * Result of a conversion.
+ */
+enum CodecStatus
+{
+	CODEC_OK,
+	CODEC_EMPTY,					// Nothing to decode
+	CODEC_INVALID_CHARACTER,		// Not a decimal number
+	CODEC_OUT_OF_RANGE,				// Does not fit in an int
+	CODEC_BUFFER_TOO_SMALL,			// Not enough room to encode
+};
+
+namespace number_codec
+{
+	/**
+	 * Writes the decimal representation of value into buffer, not zero terminated.
+	 * @param[out] uint32_t* length, the number of characters written.
+	 */
+	CodecStatus 	encodeInt(int value, char* buffer, uint32_t size, uint32_t* length);
+
+	/**
+	 * Parses an optionally signed decimal integer, all length characters have to be part of the number.
+	 */
+	CodecStatus 	decodeInt(const char* data, uint32_t length, int* value);
+	CodecStatus 	decodeInt(const std::string& data, int* value);
+
+	//! Appends the decimal representation of value to a string.
+	void 			appendInt(int value, std::string& string);
+	//! @return The decimal representation of value.
+	std::string 	intToString(int value);
+
+	//! @return A description of the status for printing purposes.
+	const char* 	statusString(CodecStatus status);
+}
+
+#endif // NUMBER_CODEC_HPP
@@ -0,0 +1,255 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Compile-time typed command schemas. A command is declared once with its id,
+* 	the types of its request fields and the types of its response fields, the
+* 	templates generate the encoder and the response decoder/validator for it.
+* 	Header only due to templates.
+*
+***********************************************************************************/
+
+#ifndef TYPED_COMMAND_HPP
+#define TYPED_COMMAND_HPP
+
+#include <stdint.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+#include "rose_hardware_controller/controller_response.hpp"
+#include "rose_hardware_controller/number_codec.hpp"
+
+/**
+ * Response field that has to be present but of which the value is not used.
+ */
+struct IgnoredField
+{};
+
+/**
+ * Response field that has to echo request field I.
+ */
+template<size_t I> struct EchoField
+{};
+
+/**
+ * Response field type std::vector<int> takes all remaining data items, it can only be the last field.
+ */
+typedef std::vector<int> RepeatedField;
+
+/**
+ * Encoding and decoding of a single field, specialized per field type.
+ */
+template<class T> struct TypedField;
+
+template<> struct TypedField<int>
+{
+	static const uint32_t max_length = NUMBER_CODEC_MAX_INT_LENGTH + 1;		// Including separator
+
+	static bool encode(int value, char*& position, char* end)
+	{
+		uint32_t length;
+		if(end - position < 1 || number_codec::encodeInt(value, position, end - position - 1, &length) != CODEC_OK)
+			return false;
+
+		position 	+= length;
+		*position++ = ',';
+		return true;
+	}
+
+	static void encodeBinary(int value, char* message, uint32_t index)
+	{
+		binary_frame::setDataItem(value, message, index);
+	}
+
+	template<class Request>
+	static bool decode(ControllerResponse& response, uint32_t& index, const Request& /* request */, int& value)
+	{
+		return response.getReceivedDataItemInt(index++, &value);
+	}
+
+	static const bool is_repeated = false;
+};
+
+template<> struct TypedField<IgnoredField>
+{
+	template<class Request>
+	static bool decode(ControllerResponse& /* response */, uint32_t& index, const Request& /* request */, IgnoredField& /* value */)
+	{
+		index++;
+		return true;
+	}
+
+	static const bool is_repeated = false;
+};
+
+template<size_t I> struct TypedField< EchoField<I> >
+{
+	template<class Request>
+	static bool decode(ControllerResponse& response, uint32_t& index, const Request& request, EchoField<I>& /* value */)
+	{
+		int echoed;
+		return response.getReceivedDataItemInt(index++, &echoed) && echoed == std::get<I>(request);
+	}
+
+	static const bool is_repeated = false;
+};
+
+template<> struct TypedField<RepeatedField>
+{
+	template<class Request>
+	static bool decode(ControllerResponse& response, uint32_t& index, const Request& /* request */, RepeatedField& values)
+	{
+		values.resize(response.getNrOfReceivedDataItems() - index);
+		for(auto& value : values)
+		{
+			if(!response.getReceivedDataItemInt(index++, &value))
+				return false;
+		}
+		return true;
+	}
+
+	static const bool is_repeated = true;
+};
+
+/**
+ * Recursion over the fields of a tuple, I is the current field and N the number of fields.
+ */
+template<size_t I, size_t N> struct TypedFields
+{
+	typedef TypedFields<I + 1, N> Next;
+
+	template<class Tuple>
+	static bool encode(const Tuple& fields, char*& position, char* end)
+	{
+		return 	TypedField<typename std::tuple_element<I, Tuple>::type>::encode(std::get<I>(fields), position, end) &&
+				Next::encode(fields, position, end);
+	}
+
+	template<class Tuple>
+	static void encodeBinary(const Tuple& fields, char* message)
+	{
+		TypedField<typename std::tuple_element<I, Tuple>::type>::encodeBinary(std::get<I>(fields), message, I);
+		Next::encodeBinary(fields, message);
+	}
+
+	template<class Tuple, class Request>
+	static bool decode(ControllerResponse& response, uint32_t& index, const Request& request, Tuple& fields)
+	{
+		return 	TypedField<typename std::tuple_element<I, Tuple>::type>::decode(response, index, request, std::get<I>(fields)) &&
+				Next::decode(response, index, request, fields);
+	}
+};
+
+template<size_t N> struct TypedFields<N, N>
+{
+	template<class Tuple>
+	static bool encode(const Tuple& /* fields */, char*& /* position */, char* /* end */)
+	{
+		return true;
+	}
+
+	template<class Tuple>
+	static void encodeBinary(const Tuple& /* fields */, char* /* message */)
+	{}
+
+	template<class Tuple, class Request>
+	static bool decode(ControllerResponse& /* response */, uint32_t& /* index */, const Request& /* request */, Tuple& /* fields */)
+	{
+		return true;
+	}
+};
+
+/**
+ * Whether the last field of a tuple is a repeated field.
+ */
+template<class Tuple, size_t N = std::tuple_size<Tuple>::value> struct LastTypedField
+{
+	static const bool is_repeated = TypedField<typename std::tuple_element<N - 1, Tuple>::type>::is_repeated;
+};
+
+template<class Tuple> struct LastTypedField<Tuple, 0>
+{
+	static const bool is_repeated = false;
+};
+
+/**
+ * A command schema, for example:
+ * 	typedef TypedCommand<112, std::tuple<int>, std::tuple< EchoField<0> > > SetThresholdCommand;
+ * declares command 112 with one integer request field, of which the response echoes the value.
+ */
+template<int Id, class RequestFields, class ResponseFields> class TypedCommand;
+
+template<int Id, class... RequestTypes, class... ResponseTypes>
+class TypedCommand<Id, std::tuple<RequestTypes...>, std::tuple<ResponseTypes...> >
+{
+  public:
+	typedef std::tuple<RequestTypes...> 	Request;
+	typedef std::tuple<ResponseTypes...> 	Response;
+
+	static const int 		id 					= Id;
+	static const size_t 	nr_request_fields 	= sizeof...(RequestTypes);
+	static const size_t 	nr_response_fields 	= sizeof...(ResponseTypes);
+
+	// '$', the id and every request field including their separators and the '\r'
+	static const uint32_t 	max_request_length 	= 1 + TypedField<int>::max_length * (1 + sizeof...(RequestTypes)) + 1;
+	// The type and every request field of the binary frame format, before framing
+	static const uint32_t 	binary_request_length 	= BINARY_FRAME_TYPE_SIZE + BINARY_FRAME_ITEM_SIZE * sizeof...(RequestTypes);
+
+	static_assert(Id >= 0 && Id <= 0xFFFF, "The id of a command has to fit the type field of the binary frame format");
+
+	/**
+	 * Encodes the request into a buffer of at least max_request_length bytes.
+	 * @return The length of the message, 0 if the buffer is too small.
+	 */
+	static uint32_t encode(const Request& request, char* buffer, uint32_t size)
+	{
+		char* position 	= buffer;
+		char* end 		= buffer + size;
+
+		*position++ = '$';
+		if(!TypedField<int>::encode(Id, position, end) || !TypedFields<0, nr_request_fields>::encode(request, position, end) || position == end)
+			return 0;
+
+		*position++ = '\r';
+		return position - buffer;
+	}
+
+	/**
+	 * Appends the frame of the request in the binary frame format to a string, without going through the ASCII message.
+	 */
+	static void appendBinary(const Request& request, std::string& frame)
+	{
+		char message[binary_request_length];
+		binary_frame::setType(Id, message);
+		TypedFields<0, nr_request_fields>::encodeBinary(request, message);
+		binary_frame::appendFrame(message, binary_request_length, frame);
+	}
+
+	/**
+	 * Validates the type and the number of data items of a response and decodes them into the response fields.
+	 * @return false if the response does not match the schema.
+	 */
+	static bool decode(ControllerResponse& response, const Request& request, Response& fields)
+	{
+		int type;
+		if(!response.getTypeInt(&type) || type != Id)
+			return false;
+
+		// A repeated last field takes any number of remaining data items
+		uint32_t nr_received = response.getNrOfReceivedDataItems();
+		if(LastTypedField<Response>::is_repeated ? nr_received < nr_response_fields - 1 : nr_received != nr_response_fields)
+			return false;
+
+		uint32_t index = 0;
+		return TypedFields<0, nr_response_fields>::decode(response, index, request, fields);
+	}
+};
+
+#endif // TYPED_COMMAND_HPP
@@ -0,0 +1,267 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Binary frame format of the controller protocol.
+*
+***********************************************************************************/
+
+#include "rose_hardware_controller/binary_frame.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rose_hardware_controller/number_codec.hpp"
+
+namespace binary_frame
+{
+
+// Remainder of every byte value, one lookup per byte
+struct Crc16Table
+{
+	Crc16Table()
+	{
+		for(uint32_t byte = 0; byte < 256; byte++)
+		{
+			uint16_t crc = byte << 8;
+			for(int bit = 0; bit < 8; bit++)
+				crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+			entries[byte] = crc;
+		}
+	}
+
+	uint16_t entries[256];
+};
+
+static const Crc16Table CRC16_TABLE;
+
+uint16_t crc16(const char* data, uint32_t length)
+{
+	uint16_t crc = 0xFFFF;
+	for(uint32_t i = 0; i < length; i++)
+		crc = (crc << 8) ^ CRC16_TABLE.entries[(crc >> 8) ^ (uint8_t)data[i]];
+
+	return crc;
+}
+
+static void appendUint16(uint16_t value, std::string& string)
+{
+	string += (char)(value & 0xFF);
+	string += (char)(value >> 8);
+}
+
+static void appendInt32(int value, std::string& string)
+{
+	uint32_t bits = value;
+	string += (char)(bits & 0xFF);
+	string += (char)((bits >> 8) & 0xFF);
+	string += (char)((bits >> 16) & 0xFF);
+	string += (char)(bits >> 24);
+}
+
+// A code byte gives the distance to the next zero, it replaces that zero
+class CobsEncoder
+{
+  public:
+	CobsEncoder(std::string& frame)
+		: frame_(frame)
+		, code_index_(frame.length())
+		, code_(1)
+	{
+		frame_ += (char)code_;
+	}
+
+	void append(const char* data, uint32_t length)
+	{
+		uint32_t i = 0;
+		while(i < length)
+		{
+			// Copy the non-zero bytes that still fit in the block in one go
+			uint32_t run = 0;
+			while(run < 0xFFu - code_ && i + run < length && data[i + run] != 0)
+				run++;
+
+			frame_.append(data + i, run);
+			code_ 	+= run;
+			i 		+= run;
+
+			// A full block of 254 data bytes is not followed by a zero, else the block ends at a zero
+			if(code_ == 0xFF)
+				nextBlock();
+			else if(i < length)
+			{
+				nextBlock();
+				i++;
+			}
+		}
+	}
+
+	void finish()
+	{
+		frame_[code_index_] = (char)code_;
+	}
+
+  private:
+	void nextBlock()
+	{
+		frame_[code_index_] = (char)code_;
+		code_index_ 		= frame_.length();
+		code_ 				= 1;
+		frame_ += (char)code_;
+	}
+
+	std::string& 	frame_;
+	size_t 			code_index_;
+	uint8_t 		code_;
+};
+
+void appendFrame(const char* message, uint32_t length, std::string& frame)
+{
+	char 		crc_bytes[BINARY_FRAME_CRC_SIZE];
+	uint16_t 	crc = crc16(message, length);
+	crc_bytes[0] 	= crc & 0xFF;
+	crc_bytes[1] 	= crc >> 8;
+
+	// The message and the CRC are encoded as one block of data
+	frame.reserve(frame.length() + length + BINARY_FRAME_CRC_SIZE + (length + BINARY_FRAME_CRC_SIZE) / 254 + 2);
+	CobsEncoder encoder(frame);
+	encoder.append(message, length);
+	encoder.append(crc_bytes, BINARY_FRAME_CRC_SIZE);
+	encoder.finish();
+	frame += BINARY_FRAME_DELIMITER;
+}
+
+bool decodeFrame(char* frame, uint32_t length, uint32_t* message_length)
+{
+	// The decoded bytes are never ahead of the encoded ones
+	uint32_t read 	= 0;
+	uint32_t write 	= 0;
+	while(read < length)
+	{
+		uint8_t code = frame[read];
+		if(code == 0 || read + code > length)
+			return false;
+
+		read++;
+		memmove(frame + write, frame + read, code - 1);
+		read 	+= code - 1;
+		write 	+= code - 1;
+
+		if(code != 0xFF && read < length)
+			frame[write++] = 0;
+	}
+
+	if(write < BINARY_FRAME_TYPE_SIZE + BINARY_FRAME_CRC_SIZE)
+		return false;
+
+	*message_length 	= write - BINARY_FRAME_CRC_SIZE;
+	uint16_t received 	= (uint8_t)frame[*message_length] | ((uint8_t)frame[*message_length + 1] << 8);
+	return crc16(frame, *message_length) == received;
+}
+
+void appendMessage(int type, const std::vector<int>& data, std::string& frame)
+{
+	std::string message;
+	message.reserve(BINARY_FRAME_TYPE_SIZE + data.size() * BINARY_FRAME_ITEM_SIZE);
+
+	appendUint16(type, message);
+	for(auto value : data)
+		appendInt32(value, message);
+
+	appendFrame(message.data(), message.length(), frame);
+}
+
+bool convertAsciiFrames(const char* ascii, uint32_t length, std::string& frames)
+{
+	const char* end 	= ascii + length;
+	const char* start 	= ascii;
+	std::string message;
+	while((start = std::find(start, end, '$')) != end)
+	{
+		const char* frame_end 	= std::find(start + 1, end, '\r');
+		const char* comma 		= std::find(start + 1, frame_end, ',');
+
+		int type;
+		if(number_codec::decodeInt(start + 1, comma - start - 1, &type) != CODEC_OK || type < 0 || type > UINT16_MAX)
+			return false;
+
+		message.clear();
+		appendUint16(type, message);
+
+		// Like the ASCII format, an item after the last comma is not part of the message
+		while(comma != frame_end)
+		{
+			const char* item = comma + 1;
+			comma = std::find(item, frame_end, ',');
+			if(comma == frame_end)
+				break;
+
+			int value;
+			if(number_codec::decodeInt(item, comma - item, &value) != CODEC_OK)
+				return false;
+
+			appendInt32(value, message);
+		}
+
+		appendFrame(message.data(), message.length(), frames);
+		start = frame_end;
+	}
+
+	return true;
+}
+
+bool decodeMessage(const char* message, uint32_t length, int* type, std::vector<int>& data)
+{
+	int nr_of_data_items = getNrOfDataItems(length);
+	if(nr_of_data_items < 0)
+		return false;
+
+	*type = getType(message);
+	data.resize(nr_of_data_items);
+	for(int i = 0; i < nr_of_data_items; i++)
+		data[i] = getDataItem(message, i);
+
+	return true;
+}
+
+int getNrOfDataItems(uint32_t message_length)
+{
+	if(message_length < BINARY_FRAME_TYPE_SIZE || (message_length - BINARY_FRAME_TYPE_SIZE) % BINARY_FRAME_ITEM_SIZE != 0)
+		return -1;
+
+	return (message_length - BINARY_FRAME_TYPE_SIZE) / BINARY_FRAME_ITEM_SIZE;
+}
+
+int getType(const char* message)
+{
+	return (uint8_t)message[0] | ((uint8_t)message[1] << 8);
+}
+
+int getDataItem(const char* message, uint32_t index)
+{
+	const uint8_t* item = (const uint8_t*)message + BINARY_FRAME_TYPE_SIZE + index * BINARY_FRAME_ITEM_SIZE;
+	return (int)((uint32_t)item[0] | ((uint32_t)item[1] << 8) | ((uint32_t)item[2] << 16) | ((uint32_t)item[3] << 24));
+}
+
+void setType(int type, char* message)
+{
+	message[0] = type & 0xFF;
+	message[1] = (type >> 8) & 0xFF;
+}
+
+void setDataItem(int value, char* message, uint32_t index)
+{
+	uint32_t 	bits = value;
+	char* 		item = message + BINARY_FRAME_TYPE_SIZE + index * BINARY_FRAME_ITEM_SIZE;
+	item[0] = bits & 0xFF;
+	item[1] = (bits >> 8) & 0xFF;
+	item[2] = (bits >> 16) & 0xFF;
+	item[3] = bits >> 24;
+}
+
+}
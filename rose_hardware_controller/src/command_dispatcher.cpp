@@ -0,0 +1,763 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Dispatcher that owns the link to a low-level controller.
+*
+***********************************************************************************/
+
+#include "rose_hardware_controller/command_dispatcher.hpp"
+
+#include <algorithm>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+
+CommandClassStats::CommandClassStats()
+	: n_completed(0)
+	, n_failed(0)
+	, n_rejected(0)
+	, n_retries(0)
+	, max_queued(0)
+	, total_latency(0)
+	, max_latency(0)
+	, max_queue_wait(0)
+{}
+
+CommandResult::CommandResult()
+	: success(false)
+	, timed_out(false)
+	, latency(0)
+	, n_retries(0)
+{}
+
+CommandTransaction::CommandTransaction(const std::string& message)
+	: message(message)
+	, pipeline_depth(1)
+	, match_by_type(false)
+	, priority(COMMAND_PRIORITY_CONTROL)
+	, retryable(false)
+	, switches_frame_format(false)
+	, frame_format(FRAME_FORMAT_ASCII)
+	, n_received(0)
+{}
+
+CommandTransaction::CommandTransaction(const char* message, uint32_t length)
+	: message(message, length)
+	, pipeline_depth(1)
+	, match_by_type(false)
+	, priority(COMMAND_PRIORITY_CONTROL)
+	, retryable(false)
+	, switches_frame_format(false)
+	, frame_format(FRAME_FORMAT_ASCII)
+	, n_received(0)
+{}
+
+void CommandTransaction::expectResponse(const ControllerResponse& expected_response, ResponseChecker checker)
+{
+	expected.push_back(expected_response);
+	checkers.push_back(checker);
+}
+
+CommandDispatcher::CommandDispatcher()
+	: comm_interface_(NULL)
+	, running_(false)
+	, writing_(false)
+	, frame_format_(FRAME_FORMAT_ASCII)
+	, n_telemetry_responses_(0)
+	, n_frame_errors_(0)
+	, n_discarded_responses_(0)
+{
+	queue_limits_[COMMAND_PRIORITY_SAFETY] 	= COMMAND_DISPATCHER_SAFETY_QUEUE_LIMIT;
+	queue_limits_[COMMAND_PRIORITY_CONTROL] = COMMAND_DISPATCHER_CONTROL_QUEUE_LIMIT;
+	queue_limits_[COMMAND_PRIORITY_BULK] 	= COMMAND_DISPATCHER_BULK_QUEUE_LIMIT;
+	retry_limits_[COMMAND_PRIORITY_SAFETY] 	= COMMAND_DISPATCHER_SAFETY_RETRY_LIMIT;
+	retry_limits_[COMMAND_PRIORITY_CONTROL] = COMMAND_DISPATCHER_CONTROL_RETRY_LIMIT;
+	retry_limits_[COMMAND_PRIORITY_BULK] 	= COMMAND_DISPATCHER_BULK_RETRY_LIMIT;
+}
+
+CommandDispatcher::~CommandDispatcher()
+{
+	stop();
+}
+
+void CommandDispatcher::set_comm_interface(HardwareComm* comm_interface)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	comm_interface_ = comm_interface;
+}
+
+void CommandDispatcher::start()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	running_ = true;
+}
+
+void CommandDispatcher::stop()
+{
+	std::vector<CommandTransactionPtr> completed;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		running_ = false;
+
+		for(auto& transaction : in_flight_)
+			finish(transaction, false, completed);
+		for(auto& queued : queued_)
+		{
+			for(auto& transaction : queued)
+				finish(transaction, false, completed);
+			queued.clear();
+		}
+
+		// The others are in flight as well
+		for(auto& transaction : unwritten_)
+		{
+			if(transaction->expected.empty())
+				finish(transaction, false, completed);
+		}
+
+		in_flight_.clear();
+		unwritten_.clear();
+	}
+	notify(completed);
+}
+
+void CommandDispatcher::set_write_notifier(std::function<void()> notifier)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	write_notifier_ = notifier;
+}
+
+void CommandDispatcher::set_deadline_notifier(DeadlineNotifier notifier)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	deadline_notifier_ = notifier;
+}
+
+void CommandDispatcher::flush()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		pump();
+	}
+	write();
+}
+
+void CommandDispatcher::set_frame_format(FrameFormat frame_format)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	frame_format_ = frame_format;
+}
+
+FrameFormat CommandDispatcher::get_frame_format()
+{
+	return frame_format_;
+}
+
+void CommandDispatcher::set_queue_limit(CommandPriority priority, uint32_t limit)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	queue_limits_[priority] = limit;
+}
+
+uint32_t CommandDispatcher::get_queue_limit(CommandPriority priority)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return queue_limits_[priority];
+}
+
+void CommandDispatcher::set_retry_limit(CommandPriority priority, uint32_t limit)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	retry_limits_[priority] = limit;
+}
+
+void CommandDispatcher::set_telemetry_handler(int type, TelemetryHandler handler)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(handler)
+		telemetry_handlers_[type] = boost::shared_ptr<TelemetryHandler>(new TelemetryHandler(handler));
+	else
+		telemetry_handlers_.erase(type);
+}
+
+uint64_t CommandDispatcher::getNrOfTelemetryResponses()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return n_telemetry_responses_;
+}
+
+bool CommandDispatcher::submit(const CommandTransactionPtr& transaction)
+{
+	transaction->n_received 	= 0;
+	transaction->n_retries 		= 0;
+	transaction->queued_time 	= std::chrono::steady_clock::now();
+	transaction->write_time 	= std::chrono::steady_clock::time_point();
+	transaction->first_byte_time = std::chrono::steady_clock::time_point();
+	transaction->has_kept_response = false;
+	transaction->result 		= CommandResult();
+	transaction->result.success = true;
+
+	std::vector<CommandTransactionPtr> completed;
+	std::function<void()> notifier;
+	bool accepted;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::deque<CommandTransactionPtr>& 	queued 	= queued_[transaction->priority];
+		CommandClassStats& 					stats 	= stats_[transaction->priority];
+
+		accepted = running_ && comm_interface_ != NULL && queued.size() < queue_limits_[transaction->priority];
+		if(accepted)
+		{
+			queued.push_back(transaction);
+			stats.max_queued = std::max<uint32_t>(stats.max_queued, queued.size());
+			if(write_notifier_)
+				notifier = write_notifier_;
+			else
+				pump();
+		}
+		else
+		{
+			if(running_)
+				stats.n_rejected++;
+			finish(transaction, false, completed);
+		}
+	}
+	if(notifier)
+		notifier();
+	else
+		write();
+
+	notify(completed);
+	return accepted;
+}
+
+bool CommandDispatcher::handleResponse(ControllerResponse& response)
+{
+	std::vector<CommandTransactionPtr> 	completed;
+	boost::shared_ptr<TelemetryHandler> telemetry_handler;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		// Telemetry never completes a transaction, also not one expecting the same type
+		int 	type;
+		bool 	has_type = response.getTypeInt(&type);
+		if(!telemetry_handlers_.empty() && has_type)
+		{
+			auto found = telemetry_handlers_.find(type);
+			if(found != telemetry_handlers_.end())
+			{
+				telemetry_handler = found->second;
+				n_telemetry_responses_++;
+			}
+		}
+
+		if(telemetry_handler == NULL)
+		{
+			// The response to a write that was given up after a frame error, before it is taken for the next transaction
+			auto owed = owed_responses_.begin();
+			while(owed != owed_responses_.end() && !(has_type && owed->type == type))
+				owed++;
+
+			if(owed != owed_responses_.end())
+			{
+				// If the damaged frame was the response after all, no other follows and this one answers the oldest transaction
+				std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				if(!in_flight_.empty() && in_flight_.front()->n_received == 0 && !in_flight_.front()->has_kept_response &&
+				   in_flight_.front()->deadline != std::chrono::steady_clock::time_point::max() && in_flight_.front()->expected[0].hasSameType(response))
+				{
+					CommandTransactionPtr transaction = in_flight_.front();
+					transaction->has_kept_response 	= true;
+					transaction->result.response 	= response;
+					transaction->deadline 			= std::min(transaction->deadline, now + 2 * (now - owed->write_time));
+				}
+
+				owed_responses_.erase(owed);
+				n_discarded_responses_++;
+				return false;
+			}
+
+			if(in_flight_.empty())
+				return false;
+
+			// In order, unless the oldest transaction matches by type
+			auto matched = in_flight_.begin();
+			if((*matched)->match_by_type)
+			{
+				while(matched != in_flight_.end() && !(*matched)->expected[(*matched)->n_received].hasSameType(response))
+					matched++;
+
+				if(matched == in_flight_.end())
+					return false;
+			}
+			else if(!(*matched)->expected[(*matched)->n_received].hasSameType(response) && !(has_type && type == COMMAND_DISPATCHER_UNKNOWN_COMMAND))
+			{
+				// The expected response may still follow the late response of a transaction that timed out
+				auto late = has_type ? std::find(late_types_.begin(), late_types_.end(), type) : late_types_.end();
+				if(late != late_types_.end())
+				{
+					late_types_.erase(late);
+					n_discarded_responses_++;
+					return false;
+				}
+
+				// Nothing asked for it, a damaged response. With telemetry it may as well be damaged telemetry, of which
+				// the response of the transaction still follows.
+				if(!telemetry_handlers_.empty())
+				{
+					n_frame_errors_++;
+					return false;
+				}
+
+				frameError(false, completed);
+				matched = in_flight_.end();
+			}
+
+			if(matched != in_flight_.end())
+			{
+				CommandTransactionPtr transaction = *matched;
+				answer(transaction, response, completed);
+				pump();
+			}
+		}
+	}
+
+	write();
+	if(telemetry_handler != NULL)
+		(*telemetry_handler)(response);
+	notify(completed);
+
+	return true;
+}
+
+void CommandDispatcher::handleFrameError()
+{
+	std::vector<CommandTransactionPtr> completed;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		frameError(!telemetry_handlers_.empty(), completed);
+	}
+	write();
+	notify(completed);
+}
+
+void CommandDispatcher::handleFrameError(ControllerResponse& damaged)
+{
+	int type;
+	if(!damaged.getTypeInt(&type))
+	{
+		handleFrameError();
+		return;
+	}
+
+	std::vector<CommandTransactionPtr> completed;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto late = std::find(late_types_.begin(), late_types_.end(), type);
+		if(telemetry_handlers_.find(type) != telemetry_handlers_.end())
+			n_frame_errors_++;
+		else if(late != late_types_.end())
+		{
+			late_types_.erase(late);
+			n_frame_errors_++;
+		}
+		else
+		{
+			// The response of the transaction in flight if it has its type, else the type itself may be damaged
+			bool is_expected = !in_flight_.empty() && in_flight_.front()->expected[in_flight_.front()->n_received].hasSameType(damaged);
+			frameError(!is_expected && !telemetry_handlers_.empty(), completed);
+		}
+	}
+	write();
+	notify(completed);
+}
+
+uint64_t CommandDispatcher::getNrOfFrameErrors()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return n_frame_errors_;
+}
+
+uint64_t CommandDispatcher::getNrOfDiscardedResponses()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return n_discarded_responses_;
+}
+
+std::chrono::steady_clock::time_point CommandDispatcher::getLastExchangeTime()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return last_exchange_time_;
+}
+
+void CommandDispatcher::handleTimeouts(std::chrono::steady_clock::time_point now)
+{
+	std::vector<CommandTransactionPtr> completed;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+		// A response that did not arrive within its timeout does not follow anymore
+		owed_responses_.erase(std::remove_if(owed_responses_.begin(), owed_responses_.end(), [now](const OwedResponse& owed){ return owed.deadline <= now; }), owed_responses_.end());
+
+		std::deque<CommandTransactionPtr> in_flight = in_flight_;
+		for(auto& transaction : in_flight)
+		{
+			// An expired response is skipped, a batch keeps waiting for the responses after it
+			while(transaction->n_received < transaction->expected.size() && transaction->deadline <= now)
+			{
+				// No response to the second write followed the kept one in time, it is taken as the answer. It may have
+				// answered the first write after all, the response to the second one then still follows.
+				if(transaction->has_kept_response)
+				{
+					ControllerResponse response = transaction->result.response;
+					owe(transaction);
+					answer(transaction, response, completed);
+					continue;
+				}
+
+				int command_id = commandId(transaction, transaction->n_received);
+				if(command_id != COMMAND_LATENCY_OTHER_ID)
+				{
+					late_types_.push_back(command_id);
+					if(late_types_.size() > COMMAND_DISPATCHER_MAX_LATE_RESPONSES)
+						late_types_.pop_front();
+				}
+
+				latency_stats_.recordTimeout(command_id);
+				transaction->result.timed_out = true;
+				received(transaction, false, completed);
+			}
+		}
+		pump();
+	}
+	write();
+	notify(completed);
+}
+
+std::chrono::steady_clock::time_point CommandDispatcher::nextDeadline()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	for(auto& transaction : in_flight_)
+		deadline = std::min(deadline, transaction->deadline);
+
+	return deadline;
+}
+
+bool CommandDispatcher::isIdle()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for(auto& queued : queued_)
+	{
+		if(!queued.empty())
+			return false;
+	}
+
+	return in_flight_.empty();
+}
+
+CommandClassStats CommandDispatcher::getStats(CommandPriority priority)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_[priority];
+}
+
+void CommandDispatcher::resetStats()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for(auto& stats : stats_)
+		stats = CommandClassStats();
+}
+
+void CommandDispatcher::handleBytesReceived(std::chrono::steady_clock::time_point now)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	for(auto& transaction : in_flight_)
+	{
+		// Measured for the first response only, the later responses of a batch were requested at the same time
+		if(transaction->first_byte_time < transaction->write_time)
+		{
+			transaction->first_byte_time = now;
+			latency_stats_.recordFirstByteTime(commandId(transaction, 0), std::chrono::duration_cast<std::chrono::microseconds>(now - transaction->write_time));
+		}
+	}
+}
+
+std::vector<CommandLatencyStats> CommandDispatcher::getLatencyStats()
+{
+	return latency_stats_.snapshot();
+}
+
+void CommandDispatcher::resetLatencyStats()
+{
+	latency_stats_.reset();
+}
+
+bool CommandDispatcher::mayWrite(const CommandTransactionPtr& transaction)
+{
+	if(in_flight_.empty())
+		return true;
+
+	if(transaction->pipeline_depth <= in_flight_.size())
+		return false;
+
+	for(auto& in_flight : in_flight_)
+	{
+		if(in_flight->pipeline_depth <= 1)
+			return false;
+	}
+
+	return true;
+}
+
+std::deque<CommandTransactionPtr>* CommandDispatcher::nextQueue()
+{
+	for(auto& queued : queued_)
+	{
+		if(!queued.empty())
+			return &queued;
+	}
+
+	return NULL;
+}
+
+void CommandDispatcher::pump()
+{
+	// Lower classes do not overtake a higher class transaction that has to wait for the link
+	std::deque<CommandTransactionPtr>* queued;
+	while((queued = nextQueue()) != NULL && mayWrite(queued->front()))
+	{
+		CommandTransactionPtr transaction = queued->front();
+		queued->pop_front();
+
+		// In flight before it is written, such that its response can not arrive before it is expected. Its timeout
+		// starts when write() has written it.
+		transaction->write_time = std::chrono::steady_clock::now();
+		transaction->deadline 	= std::chrono::steady_clock::time_point::max();
+		if(!transaction->expected.empty())
+			in_flight_.push_back(transaction);
+		unwritten_.push_back(transaction);
+	}
+}
+
+void CommandDispatcher::write()
+{
+	std::vector<CommandTransactionPtr> 		completed;
+	std::chrono::steady_clock::time_point 	first_deadline = std::chrono::steady_clock::time_point::max();
+	std::unique_lock<std::mutex> 			lock(mutex_);
+
+	// The thread that is writing already writes the transactions queued since, in order
+	if(writing_)
+		return;
+
+	writing_ = true;
+	while(!unwritten_.empty())
+	{
+		CommandTransactionPtr 	transaction 	= unwritten_.front();
+		HardwareComm* 			comm_interface 	= comm_interface_;
+		FrameFormat 			frame_format 	= frame_format_;
+		unwritten_.pop_front();
+		lock.unlock();
+
+		std::chrono::steady_clock::time_point write_start = std::chrono::steady_clock::now();
+		const std::string* 	message = &transaction->message;
+		bool 				written = true;
+		if(frame_format == FRAME_FORMAT_BINARY && !transaction->binary_message.empty())
+			message = &transaction->binary_message;
+		else if(frame_format == FRAME_FORMAT_BINARY)
+		{
+			// Submitted without binary message or before the format was switched
+			binary_message_.clear();
+			written = binary_frame::convertAsciiFrames(transaction->message.data(), transaction->message.length(), binary_message_);
+			message = &binary_message_;
+		}
+
+		written = written && comm_interface->connect() && comm_interface->writeBlock(message->data(), message->length());
+		std::chrono::steady_clock::time_point write_time = std::chrono::steady_clock::now();
+
+		lock.lock();
+		auto in_flight = std::find(in_flight_.begin(), in_flight_.end(), transaction);
+		if(transaction->expected.empty())
+			finish(transaction, written, completed);
+		else if(in_flight == in_flight_.end())
+			continue; 		// Completed while it was written, for example by stop()
+		else if(!written)
+		{
+			in_flight_.erase(in_flight);
+			finish(transaction, false, completed);
+		}
+		else if(transaction->deadline == std::chrono::steady_clock::time_point::max())
+		{
+			// Every command of a batch took the write of the whole batch
+			transaction->write_time = write_time;
+			transaction->deadline 	= write_time + transaction->expected.front().get_timeout_duration();
+			first_deadline 			= std::min(first_deadline, transaction->deadline);
+			for(uint32_t i = 0; i < transaction->expected.size(); i++)
+				latency_stats_.recordWriteTime(commandId(transaction, i), std::chrono::duration_cast<std::chrono::microseconds>(write_time - write_start));
+		}
+
+		// A failed write frees the link for the next transaction
+		if(!written)
+			pump();
+	}
+	writing_ = false;
+	DeadlineNotifier deadline_notifier = deadline_notifier_;
+	lock.unlock();
+
+	if(deadline_notifier && first_deadline != std::chrono::steady_clock::time_point::max())
+		deadline_notifier(first_deadline);
+
+	notify(completed);
+}
+
+// Only a transaction alone in flight can be written again without changing the order of the responses. The damaged
+// frame is not the response of a transaction of which the write did not start yet.
+void CommandDispatcher::frameError(bool response_may_follow, std::vector<CommandTransactionPtr>& completed)
+{
+	n_frame_errors_++;
+	if(in_flight_.size() != 1 || in_flight_.front()->n_received != 0 ||
+	   std::find(unwritten_.begin(), unwritten_.end(), in_flight_.front()) != unwritten_.end())
+		return;
+
+	CommandTransactionPtr transaction = in_flight_.front();
+
+	// A response arrived after the last frame error, the damaged frame was either the one after it or another frame
+	if(transaction->has_kept_response)
+	{
+		ControllerResponse response = transaction->result.response;
+		owe(transaction);
+		answer(transaction, response, completed);
+		pump();
+		return;
+	}
+
+	// A command that must not be executed twice is not written again, it waits for the response that may still follow
+	if(!transaction->retryable && response_may_follow)
+		return;
+
+	// If the damaged frame was another frame the response to the write still follows, it must not answer the next one.
+	// After a switch of the frame format it follows in the other format and is not taken for the response of the next one.
+	in_flight_.clear();
+	if(response_may_follow && !transaction->switches_frame_format)
+		owe(transaction);
+
+	int command_id = commandId(transaction, 0);
+	if(!transaction->retryable || transaction->n_retries >= retry_limits_[transaction->priority])
+	{
+		latency_stats_.recordCheckFailure(command_id);
+		finish(transaction, false, completed);
+	}
+	else
+	{
+		transaction->n_retries++;
+		stats_[transaction->priority].n_retries++;
+		queued_[transaction->priority].push_front(transaction);
+	}
+
+	pump();
+}
+
+void CommandDispatcher::owe(const CommandTransactionPtr& transaction)
+{
+	OwedResponse owed;
+	if(!transaction->expected.front().getTypeInt(&owed.type))
+		return;
+
+	owed.write_time = transaction->write_time;
+	owed.deadline 	= transaction->write_time + transaction->expected.front().get_timeout_duration();
+	owed_responses_.push_back(owed);
+	if(owed_responses_.size() > COMMAND_DISPATCHER_MAX_LATE_RESPONSES)
+		owed_responses_.pop_front();
+}
+
+void CommandDispatcher::answer(const CommandTransactionPtr& transaction, ControllerResponse& response, std::vector<CommandTransactionPtr>& completed)
+{
+	ResponseChecker& 	checker 	= transaction->checkers[transaction->n_received];
+	int 				command_id 	= commandId(transaction, transaction->n_received);
+	bool 				passed 		= !checker || checker(response);
+
+	latency_stats_.recordRoundTripTime(command_id, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - transaction->write_time));
+	if(!passed)
+		latency_stats_.recordCheckFailure(command_id);
+	else
+	{
+		last_exchange_time_ = std::chrono::steady_clock::now();
+		if(transaction->switches_frame_format)
+			frame_format_ = transaction->frame_format;
+	}
+
+	transaction->has_kept_response 	= false;
+	transaction->result.response 	= response;
+	received(transaction, passed, completed);
+}
+
+void CommandDispatcher::received(const CommandTransactionPtr& transaction, bool success, std::vector<CommandTransactionPtr>& completed)
+{
+	transaction->result.success = transaction->result.success && success;
+	transaction->n_received++;
+
+	if(transaction->n_received < transaction->expected.size())
+	{
+		// All responses have been requested at the same time, their timeouts started at the write
+		transaction->deadline = transaction->write_time + transaction->expected[transaction->n_received].get_timeout_duration();
+		return;
+	}
+
+	for(auto it = in_flight_.begin(); it != in_flight_.end(); it++)
+	{
+		if(*it == transaction)
+		{
+			in_flight_.erase(it);
+			break;
+		}
+	}
+
+	finish(transaction, transaction->result.success, completed);
+}
+
+void CommandDispatcher::finish(const CommandTransactionPtr& transaction, bool success, std::vector<CommandTransactionPtr>& completed)
+{
+	CommandResult& result = transaction->result;
+
+	result.success 		= success;
+	result.latency 		= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - transaction->queued_time);
+	result.n_retries 	= transaction->n_retries;
+
+	CommandClassStats& stats = stats_[transaction->priority];
+	stats.n_completed++;
+	if(!success)
+		stats.n_failed++;
+	stats.total_latency += result.latency;
+	stats.max_latency 	= std::max(stats.max_latency, result.latency);
+	if(transaction->write_time >= transaction->queued_time)
+		stats.max_queue_wait = std::max(stats.max_queue_wait, std::chrono::duration_cast<std::chrono::microseconds>(transaction->write_time - transaction->queued_time));
+
+	uint32_t nr_of_data_items = result.response.getNrOfReceivedDataItems();
+	result.values.assign(nr_of_data_items, 0);
+	for(uint32_t i = 0; i < nr_of_data_items; i++)
+		result.response.getReceivedDataItemInt(i, &result.values[i]);
+
+	completed.push_back(transaction);
+}
+
+void CommandDispatcher::notify(std::vector<CommandTransactionPtr>& completed)
+{
+	for(auto& transaction : completed)
+	{
+		if(transaction->callback)
+			transaction->callback(transaction->result);
+	}
+}
+
+int CommandDispatcher::commandId(const CommandTransactionPtr& transaction, uint32_t response_index)
+{
+	int command_id;
+	if(!transaction->expected[response_index].getTypeInt(&command_id))
+		return COMMAND_LATENCY_OTHER_ID;
+
+	return command_id;
+}
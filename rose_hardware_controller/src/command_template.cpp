@@ -0,0 +1,180 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	A command that is encoded once and sent many times.
+*
+***********************************************************************************/
+
+#include "rose_hardware_controller/command_template.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+
+CommandTemplate::CommandTemplate(ControllerCommand command)
+	: command_(command.getCommand())
+	, message_length_(0)
+	, retryable_(command.isRetryable())
+	, binary_frame_stale_(false)
+	, expected_response_(command.getExpectedResponse().get_type(), ControllerTimeout(command.getExpectedResponse().get_timeout_duration()))
+{
+	std::list<ControllerData>* data_items = command.getDataItems();
+
+	// Room for every data item at the width of the widest integer, or at its own width if it is wider
+	uint32_t size = 1 + command_.length() + 1 + 1;
+	for(auto& data_item : *data_items)
+		size += std::max((uint32_t)data_item.getData().length(), (uint32_t)NUMBER_CODEC_MAX_INT_LENGTH) + 1;
+	message_.resize(size);
+
+	std::string message = command.getSerialMessage();
+	memcpy(message_.data(), message.data(), message.length());
+	message_length_ = message.length();
+
+	uint32_t offset = 1 + command_.length() + 1;
+	for(auto& data_item : *data_items)
+	{
+		Field field;
+		field.offset 	= offset;
+		field.length 	= data_item.getData().length();
+		fields_.push_back(field);
+		offset 			+= field.length + 1;
+	}
+
+	for(auto& data_item : command.getExpectedResponse().getExpectedDataItems())
+	{
+		ExpectedItem item;
+		item.pointer 		= data_item.getDataPointer();
+		item.data 			= data_item.getData();
+		item.is_checked 	= item.data != "";
+		item.is_integer 	= number_codec::decodeInt(item.data, &item.value) == CODEC_OK;
+		expected_items_.push_back(item);
+	}
+
+	// Kept unframed such that a patched data item is written in place, it is framed when it is needed
+	if(command.getBinaryMessage(binary_message_))
+		binary_frame_stale_ = true;
+	else
+		binary_message_.clear();
+
+	// Tokenized once here, checkResponse() only reads it
+	expected_response_.getNrOfReceivedDataItems();
+}
+
+const char* CommandTemplate::getMessage()
+{
+	return message_.data();
+}
+
+uint32_t CommandTemplate::getMessageLength()
+{
+	return message_length_;
+}
+
+const std::string& CommandTemplate::getCommand()
+{
+	return command_;
+}
+
+const std::string& CommandTemplate::getBinaryMessage()
+{
+	if(binary_frame_stale_)
+	{
+		binary_frame_.clear();
+		binary_frame::appendFrame(binary_message_.data(), binary_message_.size(), binary_frame_);
+		binary_frame_stale_ = false;
+	}
+
+	return binary_frame_;
+}
+
+bool CommandTemplate::isRetryable()
+{
+	return retryable_;
+}
+
+uint32_t CommandTemplate::getNrOfDataItems()
+{
+	return fields_.size();
+}
+
+bool CommandTemplate::set_data_item(uint32_t index, int value)
+{
+	if(index >= fields_.size())
+		return false;
+
+	char 		encoded[NUMBER_CODEC_MAX_INT_LENGTH];
+	uint32_t 	length;
+	number_codec::encodeInt(value, encoded, sizeof(encoded), &length);
+
+	// Shift the rest of the frame when the width changes, the buffer has room for the widest value
+	Field& 		field 	= fields_[index];
+	uint32_t 	tail 	= field.offset + field.length;
+	if(length != field.length)
+	{
+		memmove(message_.data() + field.offset + length, message_.data() + tail, message_length_ - tail);
+		message_length_ 	= message_length_ + length - field.length;
+		for(uint32_t i = index + 1; i < fields_.size(); i++)
+			fields_[i].offset = fields_[i].offset + length - field.length;
+		field.length 		= length;
+	}
+
+	memcpy(message_.data() + field.offset, encoded, length);
+
+	if(!binary_message_.empty())
+	{
+		binary_frame::setDataItem(value, binary_message_.data(), index);
+		binary_frame_stale_ = true;
+	}
+	return true;
+}
+
+bool CommandTemplate::set_expected_data_item(uint32_t index, int value)
+{
+	if(index >= expected_items_.size())
+		return false;
+
+	ExpectedItem& item 	= expected_items_[index];
+	item.is_checked 	= true;
+	item.is_integer 	= true;
+	item.value 			= value;
+	return true;
+}
+
+const ControllerResponse& CommandTemplate::getExpectedResponse()
+{
+	return expected_response_;
+}
+
+bool CommandTemplate::checkResponse(ControllerResponse& response)
+{
+	if(!expected_response_.hasSameType(response) || response.getNrOfReceivedDataItems() != expected_items_.size())
+		return false;
+
+	// Like HardwareController::checkResponse() all variables are assigned, also after a mismatch
+	bool all_data_ok = true;
+	for(uint32_t index = 0; index < expected_items_.size(); index++)
+	{
+		ExpectedItem& 	item = expected_items_[index];
+		int 			value;
+		bool 			is_integer = response.getReceivedDataItemInt(index, &value);
+		if(item.pointer != NULL && is_integer)
+			*item.pointer = value;
+
+		if(item.is_checked)
+		{
+			if(item.is_integer)
+				all_data_ok = is_integer && value == item.value && all_data_ok;
+			else
+				all_data_ok = response.receivedDataItemEquals(index, item.data) && all_data_ok;
+		}
+	}
+
+	return all_data_ok;
+}
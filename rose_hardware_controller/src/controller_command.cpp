@@ -13,16 +13,20 @@
 
 #include "rose_hardware_controller/controller_command.hpp"
 
+#include "rose_hardware_controller/binary_frame.hpp"
+
 using namespace std;
 
 ControllerCommand::ControllerCommand(const std::string& command)
 	: command_(command)
 	, expected_response_("")
+	, retryable_(false)
 {}
 
 ControllerCommand::ControllerCommand(const std::string& command, ControllerResponse expected_response)
 	: command_(command)
 	, expected_response_(expected_response)
+	, retryable_(false)
 {}
 
 ControllerCommand::~ControllerCommand()
@@ -30,7 +34,50 @@ ControllerCommand::~ControllerCommand()
 
 std::string ControllerCommand::getSerialMessage()
 {
-	return ("$" + command_ + "," + getSerialDataString() + "\r");
+	std::string message;
+	message.reserve(command_.length() + 3 + data_.size() * (NUMBER_CODEC_MAX_INT_LENGTH + 1));
+
+	message += '$';
+	message += command_;
+	message += ',';
+	for(auto it = data_.begin(); it != data_.end(); it++)
+	{
+		message += it->getData();
+		message += ',';
+	}
+	message += '\r';
+	return message;
+}
+
+bool ControllerCommand::getBinaryMessage(std::vector<char>& message)
+{
+	message.resize(BINARY_FRAME_TYPE_SIZE + data_.size() * BINARY_FRAME_ITEM_SIZE);
+
+	int type;
+	if(number_codec::decodeInt(command_, &type) != CODEC_OK || type < 0 || type > 0xFFFF)
+		return false;
+	binary_frame::setType(type, message.data());
+
+	uint32_t index = 0;
+	for(auto it = data_.begin(); it != data_.end(); it++)
+	{
+		int value;
+		if(number_codec::decodeInt(it->getData(), &value) != CODEC_OK)
+			return false;
+		binary_frame::setDataItem(value, message.data(), index++);
+	}
+
+	return true;
+}
+
+bool ControllerCommand::appendBinaryMessage(std::string& frame)
+{
+	std::vector<char> message;
+	if(!getBinaryMessage(message))
+		return false;
+
+	binary_frame::appendFrame(message.data(), message.size(), frame);
+	return true;
 }
   
 bool ControllerCommand::addDataItem(ControllerData data_item)
@@ -41,7 +88,7 @@ bool ControllerCommand::addDataItem(ControllerData data_item)
 
 bool ControllerCommand::addDataItem(const int& data_item)
 {
-	data_.push_back(ControllerData(rose_conversions::intToString(data_item)));
+	data_.push_back(ControllerData(number_codec::intToString(data_item)));
 	return true;
 }
 
@@ -79,13 +126,22 @@ void ControllerCommand::setExpectedResponse(ControllerResponse expected_response
 	expected_response_ = expected_response;
 }
 
+void ControllerCommand::setRetryable(bool retryable)
+{
+	retryable_ = retryable;
+}
+
+bool ControllerCommand::isRetryable()
+{
+	return retryable_;
+}
 
 std::string ControllerCommand::getCommand()
 {
 	return command_;
 }
 
-ControllerResponse ControllerCommand::getExpectedResponse()
+ControllerResponse& ControllerCommand::getExpectedResponse()
 {
 	return expected_response_;
 }
@@ -34,7 +34,7 @@ ControllerData::ControllerData(const std::string& data)
 
 ControllerData::ControllerData(const int& data, std::string error_message)
 {
-	Initialize(rose_conversions::intToString(data), error_message);
+	Initialize(number_codec::intToString(data), error_message);
 }
 
 ControllerData::ControllerData(const std::string& data, std::string error_message)
@@ -44,7 +44,7 @@ ControllerData::ControllerData(const std::string& data, std::string error_messag
 
 ControllerData::ControllerData(const int& data, int& data_reference)
 {
-	Initialize(rose_conversions::intToString(data), data_reference, "");
+	Initialize(number_codec::intToString(data), data_reference, "");
 }
 
 ControllerData::ControllerData(const std::string& data, int& data_reference)
@@ -54,7 +54,7 @@ ControllerData::ControllerData(const std::string& data, int& data_reference)
 
 ControllerData::ControllerData(const int& data, int& data_reference, std::string error_message)
 {
-	Initialize(rose_conversions::intToString(data), data_reference, error_message);
+	Initialize(number_codec::intToString(data), data_reference, error_message);
 }
 
 ControllerData::ControllerData(const std::string& data, int& data_reference, std::string error_message)
@@ -82,7 +82,7 @@ void ControllerData::Initialize(const std::string& data, int& data_reference, st
 ControllerData::~ControllerData()
 {}
 
-std::string ControllerData::getData()
+const std::string& ControllerData::getData()
 {
 	return data_;
 }
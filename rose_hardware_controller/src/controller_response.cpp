@@ -13,21 +13,39 @@
 
 #include "rose_hardware_controller/controller_response.hpp"
 
+#include <string.h>
+
+#include <algorithm>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+
 using namespace std;
 
+ControllerTimeout::ControllerTimeout(int seconds)
+	: duration_(std::chrono::seconds(seconds))
+{}
+
+std::chrono::microseconds ControllerTimeout::get_duration() const
+{
+	return duration_;
+}
+
 ControllerResponse::ControllerResponse()
 	: response_("")
 	, timeout_(0)
+	, tokenized_(false)
 {}
 
 ControllerResponse::ControllerResponse(const std::string& response)
 	: response_(response)
-	, timeout_(DEFAULT_TIMEOUT)
+	, timeout_(std::chrono::seconds(DEFAULT_TIMEOUT))
+	, tokenized_(false)
 {}
 
-ControllerResponse::ControllerResponse(const std::string& response, int timeout)
+ControllerResponse::ControllerResponse(const std::string& response, ControllerTimeout timeout)
 	: response_(response)
-	, timeout_(timeout)
+	, timeout_(timeout.get_duration())
+	, tokenized_(false)
 {}
 
 ControllerResponse::~ControllerResponse()
@@ -35,10 +53,11 @@ ControllerResponse::~ControllerResponse()
 
 void ControllerResponse::addCharacter(char character)
 {
-	response_ = response_ + character;
+	response_ += character;
+	tokenized_ = false;
 }
 
-std::string ControllerResponse::get_response()
+const std::string& ControllerResponse::get_response()
 {
 	return response_;
 }
@@ -46,37 +65,170 @@ std::string ControllerResponse::get_response()
 bool ControllerResponse::set_response(const std::string& response)
 {
 	response_ = response;
+	tokenize();
 	return true;
 }
 
+bool ControllerResponse::set_response(const char* response, uint32_t length)
+{
+	response_.assign(response, length);
+	tokenize();
+	return true;
+}
+
+// Writes the ASCII representation while filling in the fields, the values are known already
+bool ControllerResponse::set_binary_response(const char* message, uint32_t length)
+{
+	int nr_of_data_items = binary_frame::getNrOfDataItems(length);
+	if(nr_of_data_items < 0)
+		return false;
+
+	response_.clear();
+	response_.reserve(NUMBER_CODEC_MAX_INT_LENGTH + 1 + nr_of_data_items * (NUMBER_CODEC_MAX_INT_LENGTH + 1));
+	number_codec::appendInt(binary_frame::getType(message), response_);
+	type_length_ 	= response_.length();
+	has_separator_ 	= true;
+	response_ += ',';
+
+	fields_.clear();
+	fields_.reserve(nr_of_data_items);
+	for(int i = 0; i < nr_of_data_items; i++)
+	{
+		Field field;
+		field.offset 		= response_.length();
+		field.value 		= binary_frame::getDataItem(message, i);
+		field.is_integer 	= true;
+		number_codec::appendInt(field.value, response_);
+		field.length 		= response_.length() - field.offset;
+		fields_.push_back(field);
+		response_ += ',';
+	}
+
+	tokenized_ = true;
+	return true;
+}
+
+// Whole seconds, rounded up such that a non-zero timeout never becomes 0
 int ControllerResponse::get_timeout()
+{
+	return (timeout_.count() + 999999) / 1000000;
+}
+
+std::chrono::microseconds ControllerResponse::get_timeout_duration()
 {
 	return timeout_;
 }
 
-std::string ControllerResponse::get_type()
+// Splits the response into the type, the part before the first comma, and the comma terminated data items
+void ControllerResponse::tokenize()
 {
-	// Get the part of the string after the first comma and before the second
-    int comma_pos = response_.find(",");
-    
-    if(comma_pos != string::npos)
-        return response_.substr(0, comma_pos);
-    else
-        return response_;
+	const char* response 	= response_.data();
+	uint32_t 	length 		= response_.length();
+
+	const char* comma 	= (const char*)memchr(response, ',', length);
+	has_separator_ 		= (comma != NULL);
+	type_length_ 		= has_separator_ ? comma - response : length;
+
+	// Reserve the exact number of fields such that tokenizing allocates at most once
+	fields_.clear();
+	if(has_separator_)
+		fields_.reserve(std::count(comma + 1, response + length, ','));
+
+	// A trailing data item without terminating comma is ignored
+	uint32_t start = type_length_ + 1;
+	while(start < length)
+	{
+		const char* next_comma = (const char*)memchr(response + start, ',', length - start);
+		if(next_comma == NULL)
+			break;
+
+		Field field;
+		field.offset 		= start;
+		field.length 		= (next_comma - response) - start;
+		field.is_integer 	= (number_codec::decodeInt(response + start, field.length, &field.value) == CODEC_OK);
+		fields_.push_back(field);
+
+		start += field.length + 1;
+	}
+
+	tokenized_ = true;
 }
 
+std::string ControllerResponse::get_type()
+{
+	if(!tokenized_)
+		tokenize();
 
+	return response_.substr(0, type_length_);
+}
 
 std::string ControllerResponse::getRawData()
 {
 	// Get the part of the string behind the first comma if there is one
-    int comma_pos = response_.find(",");
-    
-    if(comma_pos != string::npos)
-        return response_.substr(comma_pos + 1);
-    else
-        return "";
+	if(!tokenized_)
+		tokenize();
 
+	if(has_separator_)
+		return response_.substr(type_length_ + 1);
+	else
+		return "";
+}
+
+bool ControllerResponse::hasSameType(ControllerResponse& other)
+{
+	if(!tokenized_)
+		tokenize();
+	if(!other.tokenized_)
+		other.tokenize();
+
+	return 	type_length_ == other.type_length_ && 
+			memcmp(response_.data(), other.response_.data(), type_length_) == 0;
+}
+
+bool ControllerResponse::getTypeInt(int* type)
+{
+	if(!tokenized_)
+		tokenize();
+
+	return number_codec::decodeInt(response_.data(), type_length_, type) == CODEC_OK;
+}
+
+uint32_t ControllerResponse::getNrOfReceivedDataItems()
+{
+	if(!tokenized_)
+		tokenize();
+
+	return fields_.size();
+}
+
+const char* ControllerResponse::getReceivedDataItem(uint32_t index, uint32_t* length)
+{
+	if(!tokenized_)
+		tokenize();
+
+	*length = fields_[index].length;
+	return response_.data() + fields_[index].offset;
+}
+
+bool ControllerResponse::getReceivedDataItemInt(uint32_t index, int* value)
+{
+	if(!tokenized_)
+		tokenize();
+
+	if(!fields_[index].is_integer)
+		return false;
+
+	*value = fields_[index].value;
+	return true;
+}
+
+bool ControllerResponse::receivedDataItemEquals(uint32_t index, const std::string& value)
+{
+	if(!tokenized_)
+		tokenize();
+
+	return 	fields_[index].length == value.length() && 
+			memcmp(response_.data() + fields_[index].offset, value.data(), value.length()) == 0;
 }
 
 std::string ControllerResponse::getPrettyReceivedData()
@@ -109,10 +261,10 @@ std::string ControllerResponse::getPrettyString()
 
 bool ControllerResponse::hasData()
 {
-	if(getRawData() == "")
-		return false;
-	else
-		return true;
+	if(!tokenized_)
+		tokenize();
+
+	return has_separator_ && response_.length() > type_length_ + 1;
 }
 
 bool ControllerResponse::addExpectedDataItem(ControllerData data_item)
@@ -121,27 +273,19 @@ bool ControllerResponse::addExpectedDataItem(ControllerData data_item)
 	return true;
 }
 
-std::list<ControllerData> ControllerResponse::getExpectedDataItems()
+std::list<ControllerData>& ControllerResponse::getExpectedDataItems()
 {
 	return expected_data_;
 }
 
 std::list<ControllerData> ControllerResponse::getReceivedDataItems()
 {
-	std::list<ControllerData> dataItems;					//! @todo OH std::list<ControllerData>
-	if(hasData())
-	{
-		std::string raw_data 	= getRawData();
-		while(raw_data != "")
-		{
-			int comma_pos = raw_data.find(",");			
-			if(comma_pos == std::string::npos)
-				break;
-
-			dataItems.push_back(ControllerData(raw_data.substr(0, comma_pos)));
-			raw_data = raw_data.substr(comma_pos + 1, raw_data.length() - comma_pos - 1);
-		}	
-	}
+	if(!tokenized_)
+		tokenize();
+
+	std::list<ControllerData> dataItems;
+	for(auto it = fields_.begin(); it != fields_.end(); it++)
+		dataItems.push_back(ControllerData(response_.substr(it->offset, it->length)));
+
 	return dataItems;
 }
-
@@ -0,0 +1,502 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Simulated low-level controller on a pseudo terminal.
+*
+***********************************************************************************/
+
+#include "rose_hardware_controller/controller_simulator.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pty.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+#include "rose_hardware_controller/number_codec.hpp"
+
+#define CONTROLLER_SIMULATOR_WRITE_WAIT 	100		// [ms] Maximum wait for the port to become writable
+
+SimulatorConfig::SimulatorConfig()
+	: controller_id(0)
+	, firmware_major_version(1)
+	, firmware_minor_version(0)
+	, nr_of_timers(0)
+	, response_delay(0)
+	, response_jitter(0)
+	, byte_loss(0.0)
+	, baudrate(0)
+	, binary_frames(false)
+	, implicit_heartbeat(false)
+	, seed(0)
+	, telemetry_type(0)
+	, telemetry_period(0)
+{}
+
+ControllerSimulator::ControllerSimulator(const SimulatorConfig& config)
+	: config_(config)
+	, master_fd_(-1)
+	, slave_fd_(-1)
+	, stop_fd_(-1)
+	, running_(false)
+	, byte_loss_(config.byte_loss)
+	, frame_format_(FRAME_FORMAT_ASCII)
+	, random_(config.seed)
+	, telemetry_count_(0)
+	, watchdog_treshold_(0)
+	, implicit_heartbeat_(false)
+	, watchdog_expired_(false)
+	, n_commands_(0)
+	, n_dropped_bytes_(0)
+	, watchdog_count_(0)
+	, n_watchdog_expirations_(0)
+{}
+
+ControllerSimulator::~ControllerSimulator()
+{
+	stop();
+}
+
+bool ControllerSimulator::start()
+{
+	if(running_)
+		return true;
+
+	char port_name[256];
+	if(openpty(&master_fd_, &slave_fd_, port_name, NULL, NULL) < 0)
+	{
+		ROS_ERROR_NAMED(ROS_NAME_SIMULATOR, "Could not open pseudo terminal: %s", strerror(errno));
+		return false;
+	}
+	port_name_ = port_name;
+
+	// Pass the bytes unaltered and never block the serving thread
+	struct termios settings;
+	tcgetattr(master_fd_, &settings);
+	cfmakeraw(&settings);
+	tcsetattr(master_fd_, TCSANOW, &settings);
+	fcntl(master_fd_, F_SETFL, fcntl(master_fd_, F_GETFL) | O_NONBLOCK);
+
+	stop_fd_ = eventfd(0, EFD_NONBLOCK);
+	if(stop_fd_ < 0)
+	{
+		ROS_ERROR_NAMED(ROS_NAME_SIMULATOR, "Could not create stop event of the simulator: %s", strerror(errno));
+		stop();
+		return false;
+	}
+
+	frame_parser_.reset();
+	frame_format_ 		= FRAME_FORMAT_ASCII;
+	watchdog_treshold_ 	= 0;
+	implicit_heartbeat_ = false;
+	watchdog_expired_ 	= false;
+	pending_.clear();
+	last_due_ 		= std::chrono::steady_clock::time_point();
+	next_telemetry_ = std::chrono::steady_clock::now() + config_.telemetry_period;
+
+	running_ 	= true;
+	thread_ 	= std::thread(&ControllerSimulator::serve, this);
+	return true;
+}
+
+void ControllerSimulator::stop()
+{
+	if(running_)
+	{
+		running_ = false;
+
+		uint64_t one = 1;
+		if(::write(stop_fd_, &one, sizeof(one)) < 0)
+			ROS_WARN_NAMED(ROS_NAME_SIMULATOR, "Could not signal stop event of the simulator: %s", strerror(errno));
+
+		thread_.join();
+	}
+
+	if(stop_fd_ >= 0)
+		close(stop_fd_);
+	if(slave_fd_ >= 0)
+		close(slave_fd_);
+	if(master_fd_ >= 0)
+		close(master_fd_);
+
+	stop_fd_ 	= -1;
+	slave_fd_ 	= -1;
+	master_fd_ 	= -1;
+}
+
+const std::string& ControllerSimulator::get_port_name()
+{
+	return port_name_;
+}
+
+void ControllerSimulator::set_register(int command, int value)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	registers_[command] = value;
+}
+
+void ControllerSimulator::set_byte_loss(double byte_loss)
+{
+	byte_loss_ = byte_loss;
+}
+
+bool ControllerSimulator::get_register(int command, int* value)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto found = registers_.find(command);
+	if(found == registers_.end())
+		return false;
+
+	*value = found->second;
+	return true;
+}
+
+void ControllerSimulator::set_handler(int command, SimulatorHandler handler)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if(handler)
+		handlers_[command] = handler;
+	else
+		handlers_.erase(command);
+}
+
+uint64_t ControllerSimulator::getNrOfCommands()
+{
+	return n_commands_;
+}
+
+uint64_t ControllerSimulator::getNrOfDroppedBytes()
+{
+	return n_dropped_bytes_;
+}
+
+int ControllerSimulator::getWatchdogCount()
+{
+	return watchdog_count_;
+}
+
+uint64_t ControllerSimulator::getNrOfWatchdogExpirations()
+{
+	return n_watchdog_expirations_;
+}
+
+void ControllerSimulator::serve()
+{
+	struct pollfd poll_fds[2];
+	poll_fds[0].fd 		= master_fd_;
+	poll_fds[0].events 	= POLLIN;
+	poll_fds[1].fd 		= stop_fd_;
+	poll_fds[1].events 	= POLLIN;
+
+	char buffer[CONTROLLER_SIMULATOR_READ_SIZE];
+	while(running_)
+	{
+		// Sleep until a command arrives or the next response or telemetry frame is due
+		std::chrono::steady_clock::time_point now 	= std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point wake 	= std::chrono::steady_clock::time_point::max();
+		if(!pending_.empty())
+			wake = pending_.begin()->first;
+		if(config_.telemetry_type != 0)
+			wake = std::min(wake, next_telemetry_);
+		wake = std::min(wake, watchdogDeadline());
+
+		struct timespec 	timeout;
+		struct timespec* 	timeout_pointer = NULL;
+		if(wake != std::chrono::steady_clock::time_point::max())
+		{
+			std::chrono::nanoseconds wait = std::max(std::chrono::nanoseconds(0), std::chrono::duration_cast<std::chrono::nanoseconds>(wake - now));
+			timeout.tv_sec 	= wait.count() / 1000000000;
+			timeout.tv_nsec = wait.count() % 1000000000;
+			timeout_pointer = &timeout;
+		}
+
+		// The slave side is kept open, so the master does not hang up when a Serial disconnects
+		if(ppoll(poll_fds, 2, timeout_pointer, NULL) < 0 && errno != EINTR)
+		{
+			ROS_ERROR_NAMED(ROS_NAME_SIMULATOR, "Polling the simulator port failed: %s", strerror(errno));
+			break;
+		}
+
+		if(poll_fds[1].revents & POLLIN)
+			break;
+
+		now = std::chrono::steady_clock::now();
+		if(poll_fds[0].revents & POLLIN)
+		{
+			ssize_t n_read = ::read(master_fd_, buffer, sizeof(buffer));
+			bool 	frame_complete;
+			for(ssize_t n_parsed = 0; n_parsed < n_read; )
+			{
+				frame_parser_.set_frame_format(frame_format_);
+				n_parsed += frame_parser_.parse(buffer + n_parsed, n_read - n_parsed, &frame_complete);
+				if(frame_complete)
+					handleFrame(frame_parser_.getFrame(), frame_parser_.getFrameLength(), now);
+			}
+		}
+
+		if(config_.telemetry_type != 0 && next_telemetry_ <= now)
+		{
+			pending_.insert(std::make_pair(now, encodeResponse(config_.telemetry_type, std::vector<int>(1, telemetry_count_++))));
+			next_telemetry_ += std::max(config_.telemetry_period, std::chrono::microseconds(1));
+		}
+
+		writeDue(now);
+		checkWatchdog(now);
+	}
+}
+
+void ControllerSimulator::handleFrame(const char* frame, uint32_t length, std::chrono::steady_clock::time_point now)
+{
+	n_commands_++;
+
+	int 				command;
+	std::vector<int> 	request;
+	std::vector<int> 	response;
+	bool 				is_valid = decodeFrame(frame, length, &command, request);
+
+	// Setting the treshold starts the watchdog
+	if(is_valid && (command == 111 || command == 112 || implicit_heartbeat_))
+	{
+		last_heartbeat_ 	= now;
+		watchdog_expired_ 	= false;
+	}
+	if(!is_valid || !answer(command, request, response))
+	{
+		response.clear();
+		if(is_valid)
+			response.push_back(command);
+		command = CONTROLLER_SIMULATOR_UNKNOWN_COMMAND;
+	}
+
+	// The command has been received completely after its transmission time
+	uint32_t 					delimiters 	= frame_format_ == FRAME_FORMAT_ASCII ? 2 : 1;
+	std::chrono::microseconds 	delay 		= transmissionTime(length + delimiters) + config_.response_delay;
+	if(config_.response_jitter.count() > 0)
+		delay += std::chrono::microseconds(std::uniform_int_distribution<int64_t>(0, config_.response_jitter.count())(random_));
+
+	// Responses leave in the order of their commands, one at a time on the line
+	std::string encoded = encodeResponse(command, response);
+	last_due_ = std::max(last_due_, now + delay) + transmissionTime(encoded.size());
+	pending_.insert(std::make_pair(last_due_, encoded));
+
+	// The switch of the frame format is answered in the old format
+	if(command == 116 && request.size() == 1)
+		frame_format_ = (FrameFormat)request[0];
+}
+
+bool ControllerSimulator::decodeFrame(const char* frame, uint32_t length, int* command, std::vector<int>& request)
+{
+	if(frame_format_ == FRAME_FORMAT_BINARY)
+		return binary_frame::decodeMessage(frame, length, command, request);
+
+	// '<command>,<data>,...,' the item after the last comma is ignored, like the controllers do
+	const char* end 		= frame + length;
+	const char* comma 		= std::find(frame, end, ',');
+	bool 		is_valid 	= number_codec::decodeInt(frame, comma - frame, command) == CODEC_OK;
+	while(is_valid && comma != end)
+	{
+		const char* item = comma + 1;
+		comma = std::find(item, end, ',');
+		if(comma == end)
+			break;
+
+		int value;
+		is_valid = number_codec::decodeInt(item, comma - item, &value) == CODEC_OK;
+		request.push_back(value);
+	}
+
+	return is_valid;
+}
+
+bool ControllerSimulator::answer(int command, const std::vector<int>& request, std::vector<int>& response)
+{
+	SimulatorHandler handler;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto found_handler = handlers_.find(command);
+		if(found_handler != handlers_.end())
+			handler = found_handler->second;
+		else
+		{
+			auto found_register = registers_.find(command);
+			if(found_register != registers_.end())
+			{
+				if(!request.empty())
+					found_register->second = request[0];
+
+				response.push_back(found_register->second);
+				return true;
+			}
+		}
+	}
+
+	if(handler)
+		return handler(command, request, response);
+
+	switch(command)
+	{
+		case 100: 	// Controller id
+			response.push_back(config_.controller_id);
+			return true;
+
+		case 101: 	// Firmware version
+			response.push_back(config_.firmware_major_version);
+			response.push_back(config_.firmware_minor_version);
+			return true;
+
+		case 111: 	// Watchdog, echoes the toggled value with the count and two status items
+			response.push_back(request.empty() ? 0 : request[0]);
+			response.push_back(++watchdog_count_);
+			response.push_back(0);
+			response.push_back(0);
+			return true;
+
+		case 112: 	// Set watchdog treshold
+			if(request.empty())
+				return false;
+
+			watchdog_treshold_ = request[0];
+			response.push_back(watchdog_treshold_);
+			return true;
+
+		case 113: 	// Get watchdog treshold
+			response.push_back(watchdog_treshold_);
+			return true;
+
+		case 114: 	// Number of timers
+			response.push_back(config_.nr_of_timers);
+			return true;
+
+		case 115: 	// Set and current value of every timer
+			for(int i = 0; i < config_.nr_of_timers; i++)
+			{
+				response.push_back((i + 1) * 100);
+				response.push_back(0);
+			}
+			return true;
+
+		case 117: 	// Every command is a heartbeat
+			if(request.size() != 1 || (request[0] != 0 && !config_.implicit_heartbeat))
+				return false;
+
+			implicit_heartbeat_ = request[0] != 0;
+			response.push_back(request[0]);
+			return true;
+
+		case 116: 	// Frame format, switched by handleFrame() after answering
+			if(request.size() != 1 || request[0] < FRAME_FORMAT_ASCII || request[0] > FRAME_FORMAT_BINARY)
+				return false;
+			if(request[0] == FRAME_FORMAT_BINARY && !config_.binary_frames)
+				return false;
+
+			response.push_back(request[0]);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+std::string ControllerSimulator::encodeResponse(int type, const std::vector<int>& data)
+{
+	std::string response;
+	if(frame_format_ == FRAME_FORMAT_BINARY)
+	{
+		binary_frame::appendMessage(type, data, response);
+		return response;
+	}
+
+	response = "$";
+	number_codec::appendInt(type, response);
+	response += ',';
+	for(auto value : data)
+	{
+		number_codec::appendInt(value, response);
+		response += ',';
+	}
+	response += '\r';
+	return response;
+}
+
+std::chrono::microseconds ControllerSimulator::transmissionTime(uint32_t n_bytes)
+{
+	if(config_.baudrate <= 0)
+		return std::chrono::microseconds(0);
+
+	return std::chrono::microseconds((uint64_t)n_bytes * 10 * 1000000 / config_.baudrate);
+}
+
+std::chrono::steady_clock::time_point ControllerSimulator::watchdogDeadline()
+{
+	if(watchdog_treshold_ <= 0 || watchdog_expired_)
+		return std::chrono::steady_clock::time_point::max();
+
+	return last_heartbeat_ + std::chrono::milliseconds(watchdog_treshold_);
+}
+
+void ControllerSimulator::checkWatchdog(std::chrono::steady_clock::time_point now)
+{
+	if(watchdogDeadline() > now)
+		return;
+
+	watchdog_expired_ = true;
+	n_watchdog_expirations_++;
+}
+
+void ControllerSimulator::writeDue(std::chrono::steady_clock::time_point now)
+{
+	// Gather all due responses, such that they are written with as few writes as a real controller would need
+	std::string output;
+	while(!pending_.empty() && pending_.begin()->first <= now)
+	{
+		output += pending_.begin()->second;
+		pending_.erase(pending_.begin());
+	}
+
+	double byte_loss = byte_loss_;
+	if(byte_loss > 0.0)
+	{
+		std::bernoulli_distribution lost(byte_loss);
+		std::string 				kept;
+		for(auto byte : output)
+		{
+			if(lost(random_))
+				n_dropped_bytes_++;
+			else
+				kept += byte;
+		}
+		output.swap(kept);
+	}
+
+	size_t written = 0;
+	while(written < output.size() && running_)
+	{
+		ssize_t n_written = ::write(master_fd_, output.data() + written, output.size() - written);
+		if(n_written >= 0)
+		{
+			written += n_written;
+			continue;
+		}
+
+		if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			break;
+
+		// The slave side does not read, wait a bit and drop the rest when it stays full
+		struct pollfd poll_fd;
+		poll_fd.fd 		= master_fd_;
+		poll_fd.events 	= POLLOUT;
+		if(poll(&poll_fd, 1, CONTROLLER_SIMULATOR_WRITE_WAIT) <= 0)
+			break;
+	}
+}
@@ -0,0 +1,116 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Runs a simulated low-level controller until interrupted and prints the port
+* 	to connect to.
+*
+* 	controller_simulator [--id <id>] [--version <major>.<minor>] [--timers <n>]
+* 		[--delay <us>] [--jitter <us>] [--loss <probability>] [--baudrate <bits/s>] [--binary-frames <0|1>]
+* 		[--implicit-heartbeat <0|1>] [--seed <seed>] [--telemetry <type>,<period us>] [--register <register>=<value>]...
+*
+***********************************************************************************/
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "rose_hardware_controller/controller_simulator.hpp"
+
+volatile sig_atomic_t g_stop = 0;
+
+void handleSignal(int)
+{
+	g_stop = 1;
+}
+
+void usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s [--id <id>] [--version <major>.<minor>] [--timers <n>] [--delay <us>] [--jitter <us>] "
+					"[--loss <probability>] [--baudrate <bits/s>] [--binary-frames <0|1>] [--implicit-heartbeat <0|1>] [--seed <seed>] [--telemetry <type>,<period us>] [--register <register>=<value>]...\n", name);
+}
+
+int main(int argc, char** argv)
+{
+	SimulatorConfig 					config;
+	std::vector< std::pair<int, int> > 	registers;
+	for(int i = 1; i < argc; i++)
+	{
+		if(i + 1 >= argc)
+		{
+			usage(argv[0]);
+			return 1;
+		}
+
+		const char* option 	= argv[i];
+		const char* value 	= argv[++i];
+		if(strcmp(option, "--id") == 0)
+			config.controller_id = atoi(value);
+		else if(strcmp(option, "--version") == 0)
+			sscanf(value, "%d.%d", &config.firmware_major_version, &config.firmware_minor_version);
+		else if(strcmp(option, "--timers") == 0)
+			config.nr_of_timers = atoi(value);
+		else if(strcmp(option, "--delay") == 0)
+			config.response_delay = std::chrono::microseconds(atol(value));
+		else if(strcmp(option, "--jitter") == 0)
+			config.response_jitter = std::chrono::microseconds(atol(value));
+		else if(strcmp(option, "--loss") == 0)
+			config.byte_loss = atof(value);
+		else if(strcmp(option, "--baudrate") == 0)
+			config.baudrate = atoi(value);
+		else if(strcmp(option, "--binary-frames") == 0)
+			config.binary_frames = atoi(value) != 0;
+		else if(strcmp(option, "--implicit-heartbeat") == 0)
+			config.implicit_heartbeat = atoi(value) != 0;
+		else if(strcmp(option, "--seed") == 0)
+			config.seed = strtoul(value, NULL, 10);
+		else if(strcmp(option, "--telemetry") == 0)
+		{
+			long period = 0;
+			sscanf(value, "%d,%ld", &config.telemetry_type, &period);
+			config.telemetry_period = std::chrono::microseconds(period);
+		}
+		else if(strcmp(option, "--register") == 0)
+		{
+			int register_id, register_value;
+			if(sscanf(value, "%d=%d", &register_id, &register_value) != 2)
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			registers.push_back(std::make_pair(register_id, register_value));
+		}
+		else
+		{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+
+	ControllerSimulator simulator(config);
+	for(auto& register_value : registers)
+		simulator.set_register(register_value.first, register_value.second);
+
+	if(!simulator.start())
+		return 1;
+
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
+
+	printf("%s\n", simulator.get_port_name().c_str());
+	fflush(stdout);
+
+	while(!g_stop)
+		pause();
+
+	simulator.stop();
+	fprintf(stderr, "%lu commands answered, %lu response bytes dropped, %lu watchdog expirations.\n", (unsigned long)simulator.getNrOfCommands(), 
+			(unsigned long)simulator.getNrOfDroppedBytes(), (unsigned long)simulator.getNrOfWatchdogExpirations());
+	return 0;
+}
@@ -0,0 +1,180 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Streaming parser for the '$...\r' framed controller protocol.
+* 
+***********************************************************************************/
+
+#include "rose_hardware_controller/frame_parser.hpp"
+
+#include "rose_hardware_controller/binary_frame.hpp"
+
+FrameParser::FrameParser(uint32_t max_frame_length)
+	: buffer_(new char[max_frame_length])
+	, frame_format_(FRAME_FORMAT_ASCII)
+	, capacity_(max_frame_length)
+	, length_(0)
+	, frame_done_(false)
+	, overflow_(false)
+	, truncated_length_(0)
+	, overflow_count_(0)
+	, corrupt_count_(0)
+	, truncated_count_(0)
+{}
+
+FrameParser::~FrameParser()
+{
+	delete[] buffer_;
+}
+
+uint32_t FrameParser::parse(const char* data, uint32_t length, bool* frame_complete)
+{
+	*frame_complete 	= false;
+	truncated_length_ 	= 0;
+
+	// The previous call handed out a frame, start a new one
+	if(frame_done_)
+		reset();
+
+	if(frame_format_ == FRAME_FORMAT_BINARY)
+		return parseBinary(data, length, frame_complete);
+
+	// Find the first delimiter
+	uint32_t i = 0;
+	while(i < length && data[i] != FRAME_PARSER_START && data[i] != '\r' && data[i] != '\n')
+		i++;
+
+	// Append everything before it in one go
+	append(data, i);
+
+	if(i == length)
+		return length;
+
+	if(data[i] == FRAME_PARSER_START)
+	{
+		// Bytes without terminator, the end of a frame or its terminator got lost
+		if(length_ > 0 && !overflow_)
+		{
+			truncated_count_++;
+			truncated_length_ = length_;
+		}
+		reset();
+	}
+	else if(length_ > 0 && !overflow_)
+	{
+		frame_done_ 	= true;
+		*frame_complete = true;
+	}
+	else
+		reset();
+
+	return i + 1;
+}
+
+// The binary format has no start marker, every byte up to the delimiter belongs to the frame
+uint32_t FrameParser::parseBinary(const char* data, uint32_t length, bool* frame_complete)
+{
+	const char* delimiter 	= (const char*)memchr(data, BINARY_FRAME_DELIMITER, length);
+	uint32_t 	i 			= delimiter != NULL ? delimiter - data : length;
+
+	append(data, i);
+
+	if(i == length)
+		return length;
+
+	if(length_ > 0 && !overflow_)
+	{
+		if(binary_frame::decodeFrame(buffer_, length_, &length_))
+		{
+			frame_done_ 	= true;
+			*frame_complete = true;
+			return i + 1;
+		}
+
+		corrupt_count_++;
+	}
+
+	reset();
+	return i + 1;
+}
+
+void FrameParser::append(const char* data, uint32_t length)
+{
+	if(!overflow_ && length_ + length > capacity_)
+	{
+		overflow_ = true;
+		overflow_count_++;
+	}
+
+	if(!overflow_)
+	{
+		memcpy(buffer_ + length_, data, length);
+		length_ += length;
+	}
+}
+
+const char* FrameParser::getFrame()
+{
+	return buffer_;
+}
+
+uint32_t FrameParser::getFrameLength()
+{
+	return length_;
+}
+
+uint32_t FrameParser::getTruncatedFrameLength()
+{
+	return truncated_length_;
+}
+
+void FrameParser::reset()
+{
+	length_ 	= 0;
+	frame_done_ = false;
+	overflow_ 	= false;
+}
+
+bool FrameParser::isInFrame()
+{
+	return !frame_done_ && (length_ > 0 || overflow_);
+}
+
+void FrameParser::set_frame_format(FrameFormat frame_format)
+{
+	if(frame_format == frame_format_)
+		return;
+
+	frame_format_ = frame_format;
+	reset();
+}
+
+FrameFormat FrameParser::get_frame_format()
+{
+	return frame_format_;
+}
+
+uint64_t FrameParser::get_overflow_count()
+{
+	return overflow_count_;
+}
+
+uint64_t FrameParser::get_corrupt_count()
+{
+	return corrupt_count_;
+}
+
+uint64_t FrameParser::get_truncated_count()
+{
+	return truncated_count_;
+}
+
+uint64_t FrameParser::get_dropped_count()
+{
+	return overflow_count_ + corrupt_count_ + truncated_count_;
+}
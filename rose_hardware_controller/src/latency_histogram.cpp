@@ -0,0 +1,246 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Lock-free latency histograms per command type.
+*
+***********************************************************************************/
+
+#include "rose_hardware_controller/latency_histogram.hpp"
+
+#include <algorithm>
+
+LatencyHistogramSnapshot::LatencyHistogramSnapshot()
+	: count(0)
+	, total(0)
+	, min(0)
+	, max(0)
+{}
+
+std::chrono::microseconds LatencyHistogramSnapshot::getPercentile(double percentile) const
+{
+	uint64_t n_counted 	= 0;
+	for(uint32_t i = 0; i < buckets.size(); i++)
+		n_counted += buckets[i];
+
+	if(n_counted == 0)
+		return std::chrono::microseconds(0);
+
+	// The rank of the percentile, at least the first latency
+	uint64_t rank = (uint64_t)(percentile / 100.0 * n_counted + 0.5);
+	if(rank == 0)
+		rank = 1;
+
+	uint64_t n_below = 0;
+	for(uint32_t i = 0; i < buckets.size(); i++)
+	{
+		n_below += buckets[i];
+		if(n_below >= rank)
+			return std::min(max, std::chrono::microseconds(LatencyHistogram::bucketUpperBound(i)));
+	}
+
+	return max;
+}
+
+std::chrono::microseconds LatencyHistogramSnapshot::getMean() const
+{
+	if(count == 0)
+		return std::chrono::microseconds(0);
+
+	return total / count;
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+	reset();
+}
+
+void LatencyHistogram::record(std::chrono::microseconds latency)
+{
+	uint64_t latency_us = latency.count() > 0 ? latency.count() : 0;
+
+	buckets_[bucketIndex(latency_us)].fetch_add(1, std::memory_order_relaxed);
+	count_.fetch_add(1, std::memory_order_relaxed);
+	total_.fetch_add(latency_us, std::memory_order_relaxed);
+
+	uint64_t min = min_.load(std::memory_order_relaxed);
+	while(latency_us < min && !min_.compare_exchange_weak(min, latency_us, std::memory_order_relaxed))
+		;
+
+	uint64_t max = max_.load(std::memory_order_relaxed);
+	while(latency_us > max && !max_.compare_exchange_weak(max, latency_us, std::memory_order_relaxed))
+		;
+}
+
+LatencyHistogramSnapshot LatencyHistogram::snapshot() const
+{
+	LatencyHistogramSnapshot snapshot;
+	snapshot.count = count_.load(std::memory_order_relaxed);
+	if(snapshot.count == 0)
+		return snapshot;
+
+	snapshot.total 	= std::chrono::microseconds(total_.load(std::memory_order_relaxed));
+	snapshot.min 	= std::chrono::microseconds(min_.load(std::memory_order_relaxed));
+	snapshot.max 	= std::chrono::microseconds(max_.load(std::memory_order_relaxed));
+
+	snapshot.buckets.resize(LATENCY_HISTOGRAM_NR_OF_BUCKETS);
+	for(uint32_t i = 0; i < LATENCY_HISTOGRAM_NR_OF_BUCKETS; i++)
+		snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+
+	return snapshot;
+}
+
+void LatencyHistogram::reset()
+{
+	for(auto& bucket : buckets_)
+		bucket.store(0, std::memory_order_relaxed);
+
+	count_.store(0, std::memory_order_relaxed);
+	total_.store(0, std::memory_order_relaxed);
+	min_.store(UINT64_MAX, std::memory_order_relaxed);
+	max_.store(0, std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::bucketIndex(uint64_t latency_us)
+{
+	if(latency_us < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+		return latency_us;
+
+	// Position of the highest bit, the next LATENCY_HISTOGRAM_SUB_BUCKET_BITS bits select the sub bucket
+	uint32_t exponent = 63 - __builtin_clzll(latency_us);
+	if(exponent > LATENCY_HISTOGRAM_MAX_EXPONENT)
+		return LATENCY_HISTOGRAM_NR_OF_BUCKETS - 1;
+
+	uint32_t shift 		= exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+	uint32_t sub_bucket = (latency_us >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+	return 2 * LATENCY_HISTOGRAM_SUB_BUCKETS + (exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1) * LATENCY_HISTOGRAM_SUB_BUCKETS + sub_bucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(uint32_t index)
+{
+	if(index < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+		return index;
+
+	uint32_t exponent 	= (index - 2 * LATENCY_HISTOGRAM_SUB_BUCKETS) / LATENCY_HISTOGRAM_SUB_BUCKETS + LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1;
+	uint32_t sub_bucket = (index - 2 * LATENCY_HISTOGRAM_SUB_BUCKETS) % LATENCY_HISTOGRAM_SUB_BUCKETS;
+	uint32_t shift 		= exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+
+	return ((uint64_t)(LATENCY_HISTOGRAM_SUB_BUCKETS + sub_bucket + 1) << shift) - 1;
+}
+
+CommandLatencyStats::CommandLatencyStats()
+	: command_id(COMMAND_LATENCY_OTHER_ID)
+	, n_timeouts(0)
+	, n_check_failures(0)
+{}
+
+CommandLatencyTable::Slot::Slot()
+	: command_id(COMMAND_LATENCY_FREE_ID)
+	, n_timeouts(0)
+	, n_check_failures(0)
+{}
+
+CommandLatencyTable::CommandLatencyTable()
+	: slots_(new Slot[COMMAND_LATENCY_MAX_COMMANDS + 1])
+{
+	slots_[COMMAND_LATENCY_MAX_COMMANDS].command_id = COMMAND_LATENCY_OTHER_ID;
+}
+
+CommandLatencyTable::~CommandLatencyTable()
+{
+	delete[] slots_;
+}
+
+void CommandLatencyTable::recordWriteTime(int command_id, std::chrono::microseconds latency)
+{
+	slot(command_id).write_time.record(latency);
+}
+
+void CommandLatencyTable::recordFirstByteTime(int command_id, std::chrono::microseconds latency)
+{
+	slot(command_id).first_byte_time.record(latency);
+}
+
+void CommandLatencyTable::recordRoundTripTime(int command_id, std::chrono::microseconds latency)
+{
+	slot(command_id).round_trip_time.record(latency);
+}
+
+void CommandLatencyTable::recordTimeout(int command_id)
+{
+	slot(command_id).n_timeouts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CommandLatencyTable::recordCheckFailure(int command_id)
+{
+	slot(command_id).n_check_failures.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<CommandLatencyStats> CommandLatencyTable::snapshot() const
+{
+	std::vector<CommandLatencyStats> stats;
+	for(uint32_t i = 0; i <= COMMAND_LATENCY_MAX_COMMANDS; i++)
+	{
+		Slot& slot = slots_[i];
+		if(slot.command_id.load() == COMMAND_LATENCY_FREE_ID)
+			continue;
+
+		CommandLatencyStats command_stats;
+		command_stats.command_id 		= slot.command_id.load();
+		command_stats.write_time 		= slot.write_time.snapshot();
+		command_stats.first_byte_time 	= slot.first_byte_time.snapshot();
+		command_stats.round_trip_time 	= slot.round_trip_time.snapshot();
+		command_stats.n_timeouts 		= slot.n_timeouts.load(std::memory_order_relaxed);
+		command_stats.n_check_failures 	= slot.n_check_failures.load(std::memory_order_relaxed);
+
+		// The shared slot only when it has been used
+		if(i == COMMAND_LATENCY_MAX_COMMANDS && command_stats.write_time.count == 0 && command_stats.round_trip_time.count == 0 &&
+			command_stats.n_timeouts == 0 && command_stats.n_check_failures == 0)
+			continue;
+
+		stats.push_back(command_stats);
+	}
+
+	return stats;
+}
+
+void CommandLatencyTable::reset()
+{
+	for(uint32_t i = 0; i <= COMMAND_LATENCY_MAX_COMMANDS; i++)
+	{
+		slots_[i].write_time.reset();
+		slots_[i].first_byte_time.reset();
+		slots_[i].round_trip_time.reset();
+		slots_[i].n_timeouts.store(0, std::memory_order_relaxed);
+		slots_[i].n_check_failures.store(0, std::memory_order_relaxed);
+	}
+}
+
+CommandLatencyTable::Slot& CommandLatencyTable::slot(int command_id)
+{
+	if(command_id == COMMAND_LATENCY_OTHER_ID || command_id == COMMAND_LATENCY_FREE_ID)
+		return slots_[COMMAND_LATENCY_MAX_COMMANDS];
+
+	// Open addressing, a slot is claimed once and never released
+	uint32_t start = (uint32_t)command_id % COMMAND_LATENCY_MAX_COMMANDS;
+	for(uint32_t i = 0; i < COMMAND_LATENCY_MAX_COMMANDS; i++)
+	{
+		Slot& 	slot 	= slots_[(start + i) % COMMAND_LATENCY_MAX_COMMANDS];
+		int 	claimed = slot.command_id.load();
+		if(claimed == command_id)
+			return slot;
+
+		if(claimed == COMMAND_LATENCY_FREE_ID)
+		{
+			if(slot.command_id.compare_exchange_strong(claimed, command_id) || claimed == command_id)
+				return slot;
+		}
+	}
+
+	return slots_[COMMAND_LATENCY_MAX_COMMANDS];
+}
@@ -0,0 +1,137 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Non-throwing, locale independent and allocation free integer conversions.
+* 
+***********************************************************************************/
+
+#include "rose_hardware_controller/number_codec.hpp"
+
+#include <string.h>
+
+namespace number_codec
+{
+
+// Two digits at a time halves the number of divisions
+static const char DIGIT_PAIRS[] = 
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+CodecStatus encodeInt(int value, char* buffer, uint32_t size, uint32_t* length)
+{
+	// Fill a scratch buffer from the back
+	char 		scratch[NUMBER_CODEC_MAX_INT_LENGTH];
+	char* 		position 	= scratch + NUMBER_CODEC_MAX_INT_LENGTH;
+	uint32_t 	magnitude 	= value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+
+	while(magnitude >= 100)
+	{
+		uint32_t pair 	= (magnitude % 100) * 2;
+		magnitude 		/= 100;
+		*--position 	= DIGIT_PAIRS[pair + 1];
+		*--position 	= DIGIT_PAIRS[pair];
+	}
+
+	if(magnitude >= 10)
+	{
+		*--position = DIGIT_PAIRS[magnitude * 2 + 1];
+		*--position = DIGIT_PAIRS[magnitude * 2];
+	}
+	else
+		*--position = '0' + magnitude;
+
+	if(value < 0)
+		*--position = '-';
+
+	uint32_t n_characters = scratch + NUMBER_CODEC_MAX_INT_LENGTH - position;
+	if(n_characters > size)
+		return CODEC_BUFFER_TOO_SMALL;
+
+	memcpy(buffer, position, n_characters);
+	*length = n_characters;
+	return CODEC_OK;
+}
+
+CodecStatus decodeInt(const char* data, uint32_t length, int* value)
+{
+	if(length == 0)
+		return CODEC_EMPTY;
+
+	uint32_t 	i 			= 0;
+	bool 		negative 	= false;
+	if(data[0] == '-' || data[0] == '+')
+	{
+		negative = (data[0] == '-');
+		i++;
+	}
+
+	if(i == length)
+		return CODEC_INVALID_CHARACTER;
+
+	// Accumulate the magnitude, the limit of a negative number is one larger
+	uint32_t limit 		= negative ? 2147483648u : 2147483647u;
+	uint32_t magnitude 	= 0;
+	for(; i < length; i++)
+	{
+		uint32_t digit = (uint32_t)(data[i] - '0');
+		if(digit > 9)
+			return CODEC_INVALID_CHARACTER;
+
+		if(magnitude > (limit - digit) / 10)
+			return CODEC_OUT_OF_RANGE;
+
+		magnitude = magnitude * 10 + digit;
+	}
+
+	*value = negative ? (int)(0u - magnitude) : (int)magnitude;
+	return CODEC_OK;
+}
+
+CodecStatus decodeInt(const std::string& data, int* value)
+{
+	return decodeInt(data.data(), data.length(), value);
+}
+
+void appendInt(int value, std::string& string)
+{
+	char 		buffer[NUMBER_CODEC_MAX_INT_LENGTH];
+	uint32_t 	length;
+	encodeInt(value, buffer, sizeof(buffer), &length);
+	string.append(buffer, length);
+}
+
+std::string intToString(int value)
+{
+	char 		buffer[NUMBER_CODEC_MAX_INT_LENGTH];
+	uint32_t 	length;
+	encodeInt(value, buffer, sizeof(buffer), &length);
+	return std::string(buffer, length);
+}
+
+const char* statusString(CodecStatus status)
+{
+	switch(status)
+	{
+		case CODEC_OK: 					return "ok";
+		case CODEC_EMPTY: 				return "empty";
+		case CODEC_INVALID_CHARACTER: 	return "invalid character";
+		case CODEC_OUT_OF_RANGE: 		return "out of range";
+		case CODEC_BUFFER_TOO_SMALL: 	return "buffer too small";
+	}
+	return "unknown";
+}
+
+}
@@ -0,0 +1,186 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Unit tests of the number codec, the binary frame format and the frame parser.
+*
+***********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+#include "rose_hardware_controller/frame_parser.hpp"
+#include "rose_hardware_controller/number_codec.hpp"
+
+// Parses all bytes, returns the completed frames
+static std::vector<std::string> parseAll(FrameParser& frame_parser, const std::string& data)
+{
+	std::vector<std::string> frames;
+	uint32_t n_parsed = 0;
+	while(n_parsed < data.length())
+	{
+		bool frame_complete;
+		n_parsed += frame_parser.parse(data.data() + n_parsed, data.length() - n_parsed, &frame_complete);
+		if(frame_complete)
+			frames.push_back(std::string(frame_parser.getFrame(), frame_parser.getFrameLength()));
+	}
+	return frames;
+}
+
+TEST(NumberCodec, EncodesAndDecodesLimits)
+{
+	for(int value : {0, 1, -1, 42, -2147483647 - 1, 2147483647})
+	{
+		char 		buffer[NUMBER_CODEC_MAX_INT_LENGTH];
+		uint32_t 	length;
+		ASSERT_EQ(CODEC_OK, number_codec::encodeInt(value, buffer, sizeof(buffer), &length));
+		EXPECT_EQ(std::to_string(value), std::string(buffer, length));
+
+		int decoded;
+		ASSERT_EQ(CODEC_OK, number_codec::decodeInt(buffer, length, &decoded));
+		EXPECT_EQ(value, decoded);
+	}
+}
+
+TEST(NumberCodec, RejectsInvalidNumbers)
+{
+	int value;
+	EXPECT_EQ(CODEC_EMPTY, number_codec::decodeInt("", &value));
+	EXPECT_EQ(CODEC_INVALID_CHARACTER, number_codec::decodeInt("12a", &value));
+	EXPECT_EQ(CODEC_INVALID_CHARACTER, number_codec::decodeInt(" 1", &value));
+	EXPECT_EQ(CODEC_OUT_OF_RANGE, number_codec::decodeInt("2147483648", &value));
+	EXPECT_EQ(CODEC_OUT_OF_RANGE, number_codec::decodeInt("-2147483649", &value));
+	EXPECT_EQ(CODEC_OK, number_codec::decodeInt("+7", &value));
+	EXPECT_EQ(7, value);
+}
+
+TEST(NumberCodec, ReportsTooSmallBuffer)
+{
+	char 		buffer[3];
+	uint32_t 	length;
+	EXPECT_EQ(CODEC_BUFFER_TOO_SMALL, number_codec::encodeInt(-1234, buffer, sizeof(buffer), &length));
+	EXPECT_EQ("-1234", number_codec::intToString(-1234));
+}
+
+TEST(BinaryFrame, ComputesCrc16CcittFalse)
+{
+	// The check value of the CRC-16/CCITT-FALSE
+	EXPECT_EQ(0x29B1, binary_frame::crc16("123456789", 9));
+}
+
+TEST(BinaryFrame, RoundTripsMessagesWithZeros)
+{
+	for(uint32_t length : {2u, 3u, 253u, 254u, 255u, 600u})
+	{
+		std::string message(length, '\0');
+		for(uint32_t i = 0; i < length; i++)
+			message[i] = (i % 7 == 0) ? 0 : (char)i;
+
+		std::string frame;
+		binary_frame::appendFrame(message.data(), message.length(), frame);
+
+		// Only the delimiter is a zero byte
+		ASSERT_EQ(frame.length() - 1, frame.find(BINARY_FRAME_DELIMITER));
+
+		uint32_t message_length;
+		ASSERT_TRUE(binary_frame::decodeFrame(&frame[0], frame.length() - 1, &message_length));
+		EXPECT_EQ(message, std::string(frame.data(), message_length));
+	}
+}
+
+TEST(BinaryFrame, DetectsDamagedFrame)
+{
+	std::string frame;
+	binary_frame::appendMessage(200, std::vector<int>{1, -2, 3}, frame);
+	frame[4] ^= 0x10;
+
+	uint32_t message_length;
+	EXPECT_FALSE(binary_frame::decodeFrame(&frame[0], frame.length() - 1, &message_length));
+}
+
+TEST(BinaryFrame, ConvertsAsciiFrames)
+{
+	std::string converted;
+	ASSERT_TRUE(binary_frame::convertAsciiFrames("$200,5,-7,\r$101,\r", 17, converted));
+
+	std::string expected;
+	binary_frame::appendMessage(200, std::vector<int>{5, -7}, expected);
+	binary_frame::appendMessage(101, std::vector<int>(), expected);
+	EXPECT_EQ(expected, converted);
+
+	EXPECT_FALSE(binary_frame::convertAsciiFrames("$200,x,\r", 8, converted));
+	EXPECT_FALSE(binary_frame::convertAsciiFrames("$70000,\r", 8, converted));
+}
+
+TEST(BinaryFrame, DecodesMessage)
+{
+	std::string frame;
+	binary_frame::appendMessage(115, std::vector<int>{0, 2147483647, -1}, frame);
+
+	uint32_t message_length;
+	ASSERT_TRUE(binary_frame::decodeFrame(&frame[0], frame.length() - 1, &message_length));
+
+	int 				type;
+	std::vector<int> 	data;
+	ASSERT_TRUE(binary_frame::decodeMessage(frame.data(), message_length, &type, data));
+	EXPECT_EQ(115, type);
+	EXPECT_EQ((std::vector<int>{0, 2147483647, -1}), data);
+	EXPECT_EQ(-1, binary_frame::getNrOfDataItems(BINARY_FRAME_TYPE_SIZE + 3));
+}
+
+TEST(FrameParser, ParsesAsciiFramesSplitOverReads)
+{
+	FrameParser frame_parser;
+	EXPECT_TRUE(parseAll(frame_parser, "$200,1").empty());
+	EXPECT_TRUE(frame_parser.isInFrame());
+
+	std::vector<std::string> frames = parseAll(frame_parser, ",\r\n$101,1,2,\r");
+	ASSERT_EQ(2u, frames.size());
+	EXPECT_EQ("200,1,", frames[0]);
+	EXPECT_EQ("101,1,2,", frames[1]);
+	EXPECT_EQ(0u, frame_parser.get_dropped_count());
+}
+
+TEST(FrameParser, DropsFrameWithoutTerminator)
+{
+	FrameParser frame_parser;
+	std::vector<std::string> frames = parseAll(frame_parser, "$200,1$101,\r");
+	ASSERT_EQ(1u, frames.size());
+	EXPECT_EQ("101,", frames[0]);
+	EXPECT_EQ(1u, frame_parser.get_truncated_count());
+}
+
+TEST(FrameParser, DropsTooLongFrame)
+{
+	FrameParser frame_parser(8);
+	std::vector<std::string> frames = parseAll(frame_parser, "$200,123456789,\r$1,\r");
+	ASSERT_EQ(1u, frames.size());
+	EXPECT_EQ("1,", frames[0]);
+	EXPECT_EQ(1u, frame_parser.get_overflow_count());
+}
+
+TEST(FrameParser, ParsesBinaryFrames)
+{
+	FrameParser frame_parser;
+	frame_parser.set_frame_format(FRAME_FORMAT_BINARY);
+
+	std::string data;
+	binary_frame::appendMessage(200, std::vector<int>{0, 5}, data);
+	std::string damaged = data;
+	damaged[1] ^= 0x01;
+	binary_frame::appendMessage(101, std::vector<int>(), data);
+
+	std::vector<std::string> frames = parseAll(frame_parser, damaged + data);
+	ASSERT_EQ(2u, frames.size());
+	EXPECT_EQ(200, binary_frame::getType(frames[0].data()));
+	EXPECT_EQ(5, binary_frame::getDataItem(frames[0].data(), 1));
+	EXPECT_EQ(101, binary_frame::getType(frames[1].data()));
+	EXPECT_EQ(1u, frame_parser.get_corrupt_count());
+}
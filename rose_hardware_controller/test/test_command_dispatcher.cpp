@@ -0,0 +1,217 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Unit tests of the command dispatcher, on an interface that records the writes
+* 	and with the responses handed to the dispatcher by the test.
+*
+***********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "rose_hardware_controller/binary_frame.hpp"
+#include "rose_hardware_controller/command_dispatcher.hpp"
+
+/**
+ * Interface that accepts all writes and receives nothing.
+ */
+class RecordingComm : public HardwareComm
+{
+  public:
+	bool connect() 									{ return true; }
+	bool write(const char byte) 					{ return writeBlock(&byte, 1); }
+	bool writeBlock(const char* block, uint32_t write_len)
+	{
+		writes.push_back(std::string(block, write_len));
+		return true;
+	}
+	bool writeBlockSlow(const char* block, uint32_t write_len)	{ return writeBlock(block, write_len); }
+	bool read(char* /* byte */) 					{ return false; }
+	int  readBlock(char* /* block */, uint32_t /* max_read_len */)	{ return 0; }
+	bool fetchBuffer(thread_safe::deque<char>* /* buffer */) 	{ return false; }
+
+	std::vector<std::string> writes;
+};
+
+class CommandDispatcherTest : public ::testing::Test
+{
+  protected:
+	void SetUp()
+	{
+		dispatcher_.set_comm_interface(&comm_);
+		dispatcher_.start();
+	}
+
+	// The transactions still in flight fail here, while their results can still be collected
+	void TearDown()
+	{
+		dispatcher_.stop();
+	}
+
+	// A transaction expecting one response of its own type, of which the results are collected
+	CommandTransactionPtr transaction(const std::string& type, CommandPriority priority = COMMAND_PRIORITY_CONTROL)
+	{
+		CommandTransactionPtr created(new CommandTransaction("$" + type + ",\r"));
+		created->priority = priority;
+		created->expectResponse(ControllerResponse(type, ControllerTimeout(std::chrono::milliseconds(100))), ResponseChecker());
+		created->callback = [this](const CommandResult& result){ results_.push_back(result); };
+		return created;
+	}
+
+	bool respond(const std::string& response)
+	{
+		ControllerResponse received;
+		received.set_response(response);
+		return dispatcher_.handleResponse(received);
+	}
+
+	RecordingComm 				comm_;
+	CommandDispatcher 			dispatcher_;
+	std::vector<CommandResult> 	results_;
+};
+
+TEST_F(CommandDispatcherTest, CompletesTransactionWithItsResponse)
+{
+	ASSERT_TRUE(dispatcher_.submit(transaction("200")));
+	ASSERT_EQ(1u, comm_.writes.size());
+	EXPECT_EQ("$200,\r", comm_.writes[0]);
+	EXPECT_FALSE(dispatcher_.isIdle());
+
+	EXPECT_TRUE(respond("200,4,-5,"));
+	ASSERT_EQ(1u, results_.size());
+	EXPECT_TRUE(results_[0].success);
+	EXPECT_EQ((std::vector<int>{4, -5}), results_[0].values);
+	EXPECT_TRUE(dispatcher_.isIdle());
+}
+
+TEST_F(CommandDispatcherTest, WritesOneTransactionAtATime)
+{
+	dispatcher_.submit(transaction("200"));
+	dispatcher_.submit(transaction("201"));
+	EXPECT_EQ(1u, comm_.writes.size());
+
+	respond("200,");
+	ASSERT_EQ(2u, comm_.writes.size());
+	EXPECT_EQ("$201,\r", comm_.writes[1]);
+}
+
+TEST_F(CommandDispatcherTest, WritesHigherPriorityClassFirst)
+{
+	dispatcher_.submit(transaction("200"));
+	dispatcher_.submit(transaction("300", COMMAND_PRIORITY_BULK));
+	dispatcher_.submit(transaction("111", COMMAND_PRIORITY_SAFETY));
+
+	respond("200,");
+	ASSERT_EQ(2u, comm_.writes.size());
+	EXPECT_EQ("$111,\r", comm_.writes[1]);
+
+	respond("111,");
+	ASSERT_EQ(3u, comm_.writes.size());
+	EXPECT_EQ("$300,\r", comm_.writes[2]);
+}
+
+TEST_F(CommandDispatcherTest, RejectsTransactionsOfFullQueue)
+{
+	dispatcher_.set_queue_limit(COMMAND_PRIORITY_BULK, 1);
+	dispatcher_.submit(transaction("200"));
+	EXPECT_TRUE(dispatcher_.submit(transaction("300", COMMAND_PRIORITY_BULK)));
+	EXPECT_FALSE(dispatcher_.submit(transaction("301", COMMAND_PRIORITY_BULK)));
+
+	ASSERT_EQ(1u, results_.size());
+	EXPECT_FALSE(results_[0].success);
+	EXPECT_EQ(1u, dispatcher_.getStats(COMMAND_PRIORITY_BULK).n_rejected);
+}
+
+TEST_F(CommandDispatcherTest, TimesOutAndDiscardsLateResponse)
+{
+	dispatcher_.submit(transaction("200"));
+	dispatcher_.submit(transaction("201"));
+
+	dispatcher_.handleTimeouts(dispatcher_.nextDeadline());
+	ASSERT_EQ(1u, results_.size());
+	EXPECT_TRUE(results_[0].timed_out);
+	EXPECT_EQ(2u, comm_.writes.size());
+
+	// The late response does not answer the next transaction
+	EXPECT_FALSE(respond("200,"));
+	EXPECT_EQ(1u, dispatcher_.getNrOfDiscardedResponses());
+	EXPECT_TRUE(respond("201,"));
+	ASSERT_EQ(2u, results_.size());
+	EXPECT_TRUE(results_[1].success);
+}
+
+TEST_F(CommandDispatcherTest, WritesRetryableTransactionAgainAfterFrameError)
+{
+	CommandTransactionPtr retried = transaction("200");
+	retried->retryable = true;
+	dispatcher_.submit(retried);
+
+	dispatcher_.handleFrameError();
+	ASSERT_EQ(2u, comm_.writes.size());
+	EXPECT_EQ(comm_.writes[0], comm_.writes[1]);
+
+	respond("200,");
+	ASSERT_EQ(1u, results_.size());
+	EXPECT_TRUE(results_[0].success);
+	EXPECT_EQ(1u, results_[0].n_retries);
+}
+
+TEST_F(CommandDispatcherTest, FailsTransactionThatIsNotRetryableAfterFrameError)
+{
+	dispatcher_.submit(transaction("200"));
+
+	dispatcher_.handleFrameError();
+	EXPECT_EQ(1u, comm_.writes.size());
+	ASSERT_EQ(1u, results_.size());
+	EXPECT_FALSE(results_[0].success);
+	EXPECT_EQ(1u, dispatcher_.getNrOfFrameErrors());
+}
+
+TEST_F(CommandDispatcherTest, RoutesTelemetryToItsHandler)
+{
+	int n_telemetry = 0;
+	dispatcher_.set_telemetry_handler(150, [&](ControllerResponse&){ n_telemetry++; });
+	dispatcher_.submit(transaction("150"));
+
+	// Telemetry of the type the transaction expects does not answer it
+	EXPECT_TRUE(respond("150,1,"));
+	EXPECT_EQ(1, n_telemetry);
+	EXPECT_TRUE(results_.empty());
+	EXPECT_EQ(1u, dispatcher_.getNrOfTelemetryResponses());
+}
+
+TEST_F(CommandDispatcherTest, WritesBinaryMessageInBinaryFormat)
+{
+	dispatcher_.set_frame_format(FRAME_FORMAT_BINARY);
+
+	CommandTransactionPtr encoded = transaction("200");
+	binary_frame::appendMessage(200, std::vector<int>(), encoded->binary_message);
+	dispatcher_.submit(encoded);
+	ASSERT_EQ(1u, comm_.writes.size());
+	EXPECT_EQ(encoded->binary_message, comm_.writes[0]);
+
+	// Without binary message the ASCII message is converted
+	respond("200,");
+	dispatcher_.submit(transaction("200"));
+	ASSERT_EQ(2u, comm_.writes.size());
+	EXPECT_EQ(encoded->binary_message, comm_.writes[1]);
+}
+
+TEST_F(CommandDispatcherTest, FailsAllTransactionsOnStop)
+{
+	dispatcher_.submit(transaction("200"));
+	dispatcher_.submit(transaction("201"));
+	dispatcher_.stop();
+
+	ASSERT_EQ(2u, results_.size());
+	EXPECT_FALSE(results_[0].success);
+	EXPECT_FALSE(results_[1].success);
+	EXPECT_FALSE(dispatcher_.submit(transaction("202")));
+}
@@ -0,0 +1,190 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Tests of the handling of damaged frames by the hardware controller, against
+* 	a simulated controller that drops bytes of its responses and telemetry.
+*
+***********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rose_hardware_controller/controller_simulator.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define TEST_ECHO_COMMAND 		200		// Answered with the data items of the command
+#define TEST_TELEMETRY_TYPE 	150
+#define TEST_NR_OF_COMMANDS 	500
+#define TEST_FIRST_VALUE 		1000
+#define TEST_TIMEOUT 			100		// [ms]
+
+class FrameErrorTest : public ::testing::Test
+{
+  protected:
+	FrameErrorTest()
+		: n_telemetry_(0)
+		, n_misanswered_(0)
+	{}
+
+	// Starts a simulator that drops bytes once a controller has connected to it
+	void start(double byte_loss, bool telemetry, FrameFormat frame_format = FRAME_FORMAT_ASCII)
+	{
+		SimulatorConfig config;
+		config.binary_frames 	= true;
+		config.seed 			= 7;
+		if(telemetry)
+		{
+			config.telemetry_type 	= TEST_TELEMETRY_TYPE;
+			config.telemetry_period = std::chrono::microseconds(500);
+		}
+
+		simulator_.reset(new ControllerSimulator(config));
+		simulator_->set_handler(TEST_ECHO_COMMAND, [](int, const std::vector<int>& request, std::vector<int>& response){ response = request; return true; });
+		ASSERT_TRUE(simulator_->start());
+
+		controller_.reset(new HardwareController<Serial>("frame_error_test", Serial("frame_error_test", simulator_->get_port_name(), B115200, SERIAL_READ_MODE_EVENT)));
+		if(telemetry)
+			controller_->set_telemetry_handler(TEST_TELEMETRY_TYPE, [this](ControllerResponse&){ n_telemetry_++; });
+
+		ASSERT_TRUE(controller_->get_comm_interface()->connect());
+		ASSERT_TRUE(controller_->spawnReadloop());
+
+		// The link is set up without loss
+		ASSERT_TRUE(controller_->negotiateFrameFormat(frame_format));
+		simulator_->set_byte_loss(byte_loss);
+
+		controller_->resetCommandStats();
+		n_misanswered_ = 0;
+	}
+
+	void TearDown()
+	{
+		if(controller_)
+		{
+			controller_->stopReadloop();
+			controller_->get_comm_interface()->disconnect();
+		}
+		if(simulator_)
+			simulator_->stop();
+	}
+
+	/**
+	 * Sends a command of which the response echoes its value. The values of consecutive commands count up from a
+	 * four digit number, such that a damaged ASCII response can not pass for the response of the command before.
+	 */
+	CommandResult echo(int index, bool retryable)
+	{
+		int 				value 		= TEST_FIRST_VALUE + index;
+		int 				received 	= 0;
+		ControllerResponse 	expected_response(std::to_string(TEST_ECHO_COMMAND), ControllerTimeout(std::chrono::milliseconds(TEST_TIMEOUT)));
+		expected_response.addExpectedDataItem(ControllerData(value, received, "Not echoed."));
+
+		ControllerCommand command(std::to_string(TEST_ECHO_COMMAND), expected_response);
+		command.addDataItem(value);
+		command.setRetryable(retryable);
+
+		CommandResult result = controller_->executeCommandAsync(command).get();
+		if(result.success && received == value - 1)
+			n_misanswered_++;
+		return result;
+	}
+
+	boost::shared_ptr<ControllerSimulator> 			simulator_;
+	boost::shared_ptr< HardwareController<Serial> > 	controller_;
+	std::atomic<uint64_t> 							n_telemetry_;
+	uint32_t 										n_misanswered_;		// Commands that passed with the response of the command before
+};
+
+// A damaged response is written again, the response to the first write that may still follow does not answer the
+// next command. With telemetry the damaged frame may have been telemetry, the response to the first write then follows.
+TEST_F(FrameErrorTest, DamagedResponseFollowedByLateResponse)
+{
+	for(FrameFormat frame_format : {FRAME_FORMAT_ASCII, FRAME_FORMAT_BINARY})
+	{
+		SCOPED_TRACE(frame_format == FRAME_FORMAT_ASCII ? "ASCII frames" : "binary frames");
+		TearDown();
+		start(0.01, true, frame_format);
+
+		uint32_t n_failed = 0;
+		for(int i = 0; i < TEST_NR_OF_COMMANDS; i++)
+			n_failed += !echo(i, true).success;
+
+		CommandClassStats stats = controller_->getCommandStats(COMMAND_PRIORITY_CONTROL);
+		EXPECT_EQ(0u, n_misanswered_);
+		EXPECT_LT(n_failed, TEST_NR_OF_COMMANDS / 5);
+		EXPECT_GT(stats.n_retries, 0u);
+		EXPECT_GT(controller_->getNrOfDiscardedResponses(), 0u);
+		EXPECT_GT(n_telemetry_, 0u);
+	}
+}
+
+// A damaged telemetry frame is not the response of the command in flight, a command that is not retryable keeps
+// waiting for its response instead of failing. It only fails if its own response was damaged, at its timeout.
+TEST_F(FrameErrorTest, DamagedUnrelatedFrame)
+{
+	start(0.005, true, FRAME_FORMAT_BINARY);
+
+	uint32_t n_failed 		= 0;
+	uint32_t n_timed_out 	= 0;
+	for(int i = 0; i < TEST_NR_OF_COMMANDS; i++)
+	{
+		CommandResult result = echo(i, false);
+		n_failed 	+= !result.success;
+		n_timed_out += !result.success && result.timed_out;
+	}
+
+	EXPECT_EQ(0u, n_misanswered_);
+	EXPECT_EQ(0u, controller_->getCommandStats(COMMAND_PRIORITY_CONTROL).n_retries);
+	EXPECT_EQ(n_failed, n_timed_out);
+	EXPECT_GT(controller_->getNrOfFrameErrors(), n_failed);
+}
+
+// Without damaged frames every command passes at the first write
+TEST_F(FrameErrorTest, NoRetriesWithoutLoss)
+{
+	start(0.0, true);
+
+	for(int i = 0; i < TEST_NR_OF_COMMANDS; i++)
+		EXPECT_TRUE(echo(i, true).success);
+
+	EXPECT_EQ(0u, controller_->getCommandStats(COMMAND_PRIORITY_CONTROL).n_retries);
+	EXPECT_EQ(0u, controller_->getNrOfFrameErrors());
+}
+
+// A command of which every response is damaged fails when its retries are exhausted, without waiting for its timeout
+TEST_F(FrameErrorTest, RetriesExhausted)
+{
+	for(uint32_t retry_limit : {0u, 2u})
+	{
+		SCOPED_TRACE("retry limit " + std::to_string(retry_limit));
+		TearDown();
+		start(0.1, false, FRAME_FORMAT_BINARY);
+		controller_->set_retry_limit(COMMAND_PRIORITY_CONTROL, retry_limit);
+
+		uint32_t n_failed 		= 0;
+		uint32_t n_exhausted 	= 0;
+		for(int i = 0; i < 50; i++)
+		{
+			CommandResult result = echo(i, true);
+			n_failed 	+= !result.success;
+			n_exhausted += !result.success && !result.timed_out && result.n_retries == retry_limit;
+		}
+
+		CommandClassStats stats = controller_->getCommandStats(COMMAND_PRIORITY_CONTROL);
+		EXPECT_EQ(0u, n_misanswered_);
+		EXPECT_GT(n_failed, 0u);
+		EXPECT_EQ(n_failed, n_exhausted);
+		EXPECT_EQ(n_failed, stats.n_failed);
+		EXPECT_LE(stats.n_retries, retry_limit * stats.n_completed);
+	}
+}
@@ -0,0 +1,211 @@
+/***********************************************************************************
+* Copyright: Rose B.V. (2026)
+*
+* Revision History:
+*	Date  : 2026/10/17
+* 		- File created.
+*
+* Description:
+*	Tests of the hardware controller against the simulated controller, over a
+* 	pseudo terminal in both frame formats.
+*
+***********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rose_hardware_controller/controller_simulator.hpp"
+#include "rose_hardware_controller/hardware_controller.hpp"
+
+#define TEST_ECHO_COMMAND 		200		// Answered with the data items of the command
+#define TEST_REGISTER 			300
+#define TEST_TIMEOUT 			1		// [s]
+
+class HardwareControllerTest : public ::testing::Test
+{
+  protected:
+	static SimulatorConfig config()
+	{
+		SimulatorConfig config;
+		config.controller_id 	= 7;
+		config.nr_of_timers 	= 2;
+		config.binary_frames 	= true;
+		return config;
+	}
+
+	// Starts a simulator and connects a controller to it
+	void start(const SimulatorConfig& config)
+	{
+		simulator_.reset(new ControllerSimulator(config));
+		simulator_->set_handler(TEST_ECHO_COMMAND, [](int, const std::vector<int>& request, std::vector<int>& response){ response = request; return true; });
+		simulator_->set_register(TEST_REGISTER, 0);
+		ASSERT_TRUE(simulator_->start());
+
+		controller_.reset(new HardwareController<Serial>("hardware_controller_test", Serial("hardware_controller_test", simulator_->get_port_name(), B115200, SERIAL_READ_MODE_EVENT)));
+		ASSERT_TRUE(controller_->get_comm_interface()->connect());
+		ASSERT_TRUE(controller_->spawnReadloop());
+	}
+
+	void SetUp()
+	{
+		start(config());
+	}
+
+	void TearDown()
+	{
+		controller_->stopReadloop();
+		controller_->get_comm_interface()->disconnect();
+		simulator_->stop();
+	}
+
+	// Runs the exchanges of a test in both frame formats
+	void exchange(std::function<void()> exchanges)
+	{
+		{
+			SCOPED_TRACE("ASCII frames");
+			exchanges();
+		}
+
+		ASSERT_TRUE(controller_->negotiateFrameFormat(FRAME_FORMAT_BINARY));
+		ASSERT_EQ(FRAME_FORMAT_BINARY, controller_->get_frame_format());
+
+		SCOPED_TRACE("binary frames");
+		exchanges();
+	}
+
+	boost::shared_ptr<ControllerSimulator> 			simulator_;
+	boost::shared_ptr< HardwareController<Serial> > 	controller_;
+};
+
+TEST_F(HardwareControllerTest, ChecksControllerIdAndFirmwareVersion)
+{
+	exchange([this]()
+	{
+		EXPECT_TRUE(controller_->checkControllerID(7));
+		EXPECT_FALSE(controller_->checkControllerID(8));
+		EXPECT_TRUE(controller_->checkFirmwareVersion(1, 0));
+	});
+}
+
+TEST_F(HardwareControllerTest, SetsAndGetsValues)
+{
+	int value = 0;
+	exchange([this, &value]()
+	{
+		value++;
+		EXPECT_TRUE(controller_->setValue(std::to_string(TEST_REGISTER), TEST_TIMEOUT, -value * 1000));
+
+		int received = 0;
+		EXPECT_TRUE(controller_->getValue(std::to_string(TEST_REGISTER), TEST_TIMEOUT, received));
+		EXPECT_EQ(-value * 1000, received);
+
+		int registered = 0;
+		EXPECT_TRUE(simulator_->get_register(TEST_REGISTER, &registered));
+		EXPECT_EQ(-value * 1000, registered);
+	});
+}
+
+TEST_F(HardwareControllerTest, ExecutesTypedCommands)
+{
+	exchange([this]()
+	{
+		GetNrOfTimersCommand::Response nr_of_timers;
+		EXPECT_TRUE(controller_->executeTyped<GetNrOfTimersCommand>(GetNrOfTimersCommand::Request(), nr_of_timers));
+		EXPECT_EQ(2, std::get<0>(nr_of_timers));
+
+		GetTimersCommand::Response timers;
+		EXPECT_TRUE(controller_->executeTyped<GetTimersCommand>(GetTimersCommand::Request(), timers));
+		EXPECT_EQ((std::vector<int>{100, 0, 200, 0}), std::get<0>(timers));
+	});
+}
+
+TEST_F(HardwareControllerTest, ExecutesPatchedTemplate)
+{
+	int 				received = 0;
+	ControllerResponse 	expected_response(std::to_string(TEST_ECHO_COMMAND), TEST_TIMEOUT);
+	expected_response.addExpectedDataItem(ControllerData(5, "Not echoed."));
+	expected_response.addExpectedDataItem(ControllerData(received));
+
+	ControllerCommand command(std::to_string(TEST_ECHO_COMMAND), expected_response);
+	command.addDataItem(5);
+	command.addDataItem(7);
+	CommandTemplate command_template(command);
+
+	exchange([this, &command_template, &received]()
+	{
+		command_template.set_data_item(0, 5);
+		command_template.set_expected_data_item(0, 5);
+		command_template.set_data_item(1, 7);
+		EXPECT_TRUE(controller_->executeTemplate(command_template));
+		EXPECT_EQ(7, received);
+
+		for(int value : {-2147483647 - 1, 0, 123456, 2147483647})
+		{
+			command_template.set_data_item(0, value);
+			command_template.set_expected_data_item(0, value);
+			command_template.set_data_item(1, value / 3);
+			EXPECT_TRUE(controller_->executeTemplate(command_template));
+			EXPECT_EQ(value / 3, received);
+		}
+
+		// The check of the template fails the command
+		command_template.set_expected_data_item(0, 42);
+		EXPECT_FALSE(controller_->executeTemplate(command_template));
+	});
+}
+
+TEST_F(HardwareControllerTest, ExecutesBatch)
+{
+	exchange([this]()
+	{
+		std::vector<int> 				received(3, 0);
+		std::vector<ControllerCommand> 	commands;
+		for(int i = 0; i < 3; i++)
+		{
+			ControllerResponse expected_response(std::to_string(TEST_ECHO_COMMAND), TEST_TIMEOUT);
+			expected_response.addExpectedDataItem(ControllerData(received[i]));
+			commands.push_back(ControllerCommand(std::to_string(TEST_ECHO_COMMAND), expected_response));
+			commands.back().addDataItem(10 + i);
+		}
+
+		EXPECT_TRUE(controller_->executeBatch(commands));
+		EXPECT_EQ((std::vector<int>{10, 11, 12}), received);
+	});
+}
+
+TEST_F(HardwareControllerTest, FailsUnknownCommandWithoutTimeout)
+{
+	exchange([this]()
+	{
+		ControllerCommand command("250", ControllerResponse("250", TEST_TIMEOUT));
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		EXPECT_FALSE(controller_->executeCommand(command));
+		EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+	});
+}
+
+TEST_F(HardwareControllerTest, KeepsAsciiFormatIfControllerRefusesBinary)
+{
+	TearDown();
+
+	SimulatorConfig ascii_only = config();
+	ascii_only.binary_frames = false;
+	start(ascii_only);
+
+	EXPECT_FALSE(controller_->negotiateFrameFormat(FRAME_FORMAT_BINARY));
+	EXPECT_EQ(FRAME_FORMAT_ASCII, controller_->get_frame_format());
+	EXPECT_TRUE(controller_->checkControllerID(7));
+}
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+	ros::init(argc, argv, "hardware_controller_test");
+	return RUN_ALL_TESTS();
+}